@@ -82,6 +82,7 @@ namespace
     int  checkpoint_nfiles;
     int  regrid_on_restart;
     int  use_efficient_regrid;
+    bool use_fillpatch_plans;
     int  plotfile_on_restart;
     int  insitu_on_restart;
     int  checkpoint_on_restart;
@@ -90,6 +91,27 @@ namespace
     bool prereadFAHeaders;
     VisMF::Header::Version plot_headerversion(VisMF::Header::Version_v1);
     VisMF::Header::Version checkpoint_headerversion(VisMF::Header::Version_v1);
+
+    //
+    // The number of cells of the new grids whose data are owned by another
+    // process in the old grids.
+    //
+    Long regrid_cells_moved (const BoxArray& oba, const DistributionMapping& odm,
+                             const BoxArray& nba, const DistributionMapping& ndm)
+    {
+        Long ncells = 0;
+        std::vector< std::pair<int,Box> > isects;
+        for (int i = 0, N = nba.size(); i < N; ++i)
+        {
+            oba.intersections(nba[i], isects);
+            for (const auto& is : isects) {
+                if (odm[is.first] != ndm[i]) {
+                    ncells += is.second.numPts();
+                }
+            }
+        }
+        return ncells;
+    }
 }
 
 
@@ -118,6 +140,7 @@ Amr::Initialize ()
     checkpoint_nfiles        = 64;
     regrid_on_restart        = 0;
     use_efficient_regrid     = 0;
+    use_fillpatch_plans      = false;
     plotfile_on_restart      = 0;
     insitu_on_restart        = 0;
     checkpoint_on_restart    = 0;
@@ -150,6 +173,8 @@ Amr::Finalize ()
 
 bool Amr::Plot_Files_Output () { return plot_files_output; }
 
+bool Amr::UseFillPatchPlans () noexcept { return use_fillpatch_plans; }
+
 std::ostream&
 Amr::DataLog (int i)
 {
@@ -243,6 +268,7 @@ Amr::InitAmr ()
     record_grid_info       = false;
     file_name_digits       = 5;
     record_run_info_terse  = false;
+    record_regrid_info     = false;
     bUserStopRequest       = false;
     message_int            = 10;
 #if defined(AMREX_USE_SENSEI_INSITU) && !defined(AMREX_NO_SENSEI_AMR_INST)
@@ -258,6 +284,7 @@ Amr::InitAmr ()
     //
     pp.queryAdd("regrid_on_restart",regrid_on_restart);
     pp.queryAdd("use_efficient_regrid",use_efficient_regrid);
+    pp.queryAdd("fillpatch_plans",use_fillpatch_plans);
     pp.queryAdd("plotfile_on_restart",plotfile_on_restart);
     pp.queryAdd("insitu_on_restart",insitu_on_restart);
     pp.queryAdd("checkpoint_on_restart",checkpoint_on_restart);
@@ -297,6 +324,13 @@ Amr::InitAmr ()
         setRecordGridInfo(grid_file_name);
     }
 
+    if (pp.contains("regrid_log"))
+    {
+        std::string log_file_name;
+        pp.get("regrid_log",log_file_name);
+        setRecordRegridInfo(log_file_name);
+    }
+
     if (pp.contains("data_log"))
     {
       int num_datalogs = pp.countval("data_log");
@@ -785,6 +819,65 @@ Amr::setRecordRunInfoTerse (const std::string& filename)
     ParallelDescriptor::Barrier("Amr::setRecordRunInfoTerse");
 }
 
+void
+Amr::setRecordRegridInfo (const std::string& filename)
+{
+    record_regrid_info = true;
+    if (ParallelDescriptor::IOProcessor())
+    {
+        regridlog.open(filename.c_str(),std::ios::out|std::ios::app);
+        if (!regridlog.good()) {
+            amrex::FileOpenFailed(filename);
+        }
+    }
+    ParallelDescriptor::Barrier("Amr::setRecordRegridInfo");
+}
+
+Vector<Real>
+Amr::DistributionMapEfficiencies () const
+{
+    const int work_est_type = amr_level[0]->WorkEstType();
+    Vector<Real> dm_eff(finest_level+1, 0.0);
+    for (int lev = 0; lev <= finest_level; ++lev)
+    {
+        const BoxArray& ba = boxArray(lev);
+        const int N = ba.size();
+        Vector<Real> cost(N, 0.0);
+        if (work_est_type >= 0) {
+            const MultiFab& workest = amr_level[lev]->get_new_data(work_est_type);
+            for (MFIter mfi(workest); mfi.isValid(); ++mfi) {
+                cost[mfi.index()] = workest[mfi].sum<RunOn::Device>(mfi.validbox(), 0);
+            }
+            ParallelDescriptor::ReduceRealSum(cost.dataPtr(), N);
+        } else {
+            for (int i = 0; i < N; ++i) {
+                cost[i] = static_cast<Real>(ba[i].numPts());
+            }
+        }
+        DistributionMapping::ComputeDistributionMappingEfficiency(DistributionMap(lev),
+                                                                  cost, &dm_eff[lev]);
+    }
+    return dm_eff;
+}
+
+void
+Amr::printRegridLogLevels (std::ostream& os, const Vector<Real>& dm_eff) const
+{
+    const char* cost = (amr_level[0]->WorkEstType() >= 0) ? "work_estimates" : "cells";
+    os << "\"levels\":[";
+    for (int lev = 0; lev <= finest_level; ++lev)
+    {
+        const BoxArray& ba = boxArray(lev);
+        if (lev > 0) { os << ","; }
+        os << "{\"level\":" << lev
+           << ",\"cells\":" << ba.numPts()
+           << ",\"boxes\":" << ba.size()
+           << ",\"dm_efficiency\":" << dm_eff[lev]
+           << ",\"dm_cost\":\"" << cost << "\"}";
+    }
+    os << "]";
+}
+
 void
 Amr::setRecordDataInfo (int i, const std::string& filename)
 {
@@ -2194,6 +2287,24 @@ Amr::coarseTimeStep (Real stop_time)
     if (record_run_info_terse && ParallelDescriptor::IOProcessor())
         runlog_terse << level_steps[0] << " " << cumtime << " " << dt_level[0] << '\n';
 
+    if (record_regrid_info)
+    {
+        double step_time = amrex::second() - run_strt;
+        ParallelDescriptor::ReduceRealMax(step_time,ParallelDescriptor::IOProcessorNumber());
+        const Vector<Real> dm_eff = DistributionMapEfficiencies();
+        if (ParallelDescriptor::IOProcessor())
+        {
+            regridlog << "{\"event\":\"step\""
+                      << ",\"step\":" << level_steps[0]
+                      << ",\"time\":" << cumtime
+                      << ",\"dt\":" << dt_level[0]
+                      << ",\"step_time\":" << step_time
+                      << ",\"finest_level\":" << finest_level << ",";
+            printRegridLogLevels(regridlog, dm_eff);
+            regridlog << "}" << std::endl;
+        }
+    }
+
     int check_test = 0;
 
     if (check_per > 0.0)
@@ -2558,8 +2669,49 @@ Amr::regrid (int  lbase,
     Vector<BoxArray> new_grid_places(max_level+1);
     Vector<DistributionMapping> new_dmap(max_level+1);
 
+    const double t_regrid = amrex::second();
+    double t_dmap = 0.0;
+    double t_init = 0.0;
+    Long bytes_moved = 0;
+    mng_times = MakeNewGridsTimes();
+
     grid_places(lbase,time,new_finest, new_grid_places);
 
+    const double t_grid_places = amrex::second() - t_regrid;
+
+    //
+    // Append the phase times of this regrid and the new levels to the regrid log.
+    // The times are the maximum over the processes.
+    //
+    auto record_regrid = [&] (bool grids_changed, double t_post_regrid)
+    {
+        const auto& mng = LastMakeNewGridsTimes();
+        double t[] = {t_grid_places, mng.error_est, mng.collate, mng.cluster,
+                      t_dmap, t_init, t_post_regrid, amrex::second() - t_regrid};
+        ParallelDescriptor::ReduceRealMax(t, 8, ParallelDescriptor::IOProcessorNumber());
+        const Vector<Real> dm_eff = DistributionMapEfficiencies();
+        if (ParallelDescriptor::IOProcessor())
+        {
+            regridlog << "{\"event\":\"regrid\""
+                      << ",\"step\":" << level_steps[0]
+                      << ",\"time\":" << time
+                      << ",\"lbase\":" << lbase
+                      << ",\"grids_changed\":" << (grids_changed ? "true" : "false")
+                      << ",\"phase_times\":{\"grid_places\":" << t[0]
+                      << ",\"error_est\":" << t[1]
+                      << ",\"collate\":" << t[2]
+                      << ",\"cluster\":" << t[3]
+                      << ",\"distribution\":" << t[4]
+                      << ",\"init\":" << t[5]
+                      << ",\"post_regrid\":" << t[6]
+                      << ",\"total\":" << t[7] << "}"
+                      << ",\"bytes_moved\":" << bytes_moved
+                      << ",\"finest_level\":" << finest_level << ",";
+            printRegridLogLevels(regridlog, dm_eff);
+            regridlog << "}" << std::endl;
+        }
+    };
+
     bool regrid_level_zero = (!initial) && (lbase == 0)
         && ( loadbalance_with_workestimates || (new_grid_places[0] != amr_level[0]->boxArray()));
 
@@ -2584,6 +2736,9 @@ Amr::regrid (int  lbase,
             amrex::Print() << "Regridding at level lbase = " << lbase
                            << " but grids unchanged\n";
         }
+        if (record_regrid_info) {
+            record_regrid(false, 0.0);
+        }
         return;
     }
 
@@ -2607,6 +2762,17 @@ Amr::regrid (int  lbase,
 
     finest_level = new_finest;
 
+    //
+    // Bytes of state data per cell, for the regrid log.
+    //
+    Long bytes_per_cell = 0;
+    if (record_regrid_info) {
+        const DescriptorList& desc_lst = AmrLevel::get_desc_lst();
+        for (int k = 0; k < desc_lst.size(); ++k) {
+            bytes_per_cell += desc_lst[k].nComp() * sizeof(Real);
+        }
+    }
+
     //
     // Define the new grids from level start up to new_finest.
     //
@@ -2615,13 +2781,31 @@ Amr::regrid (int  lbase,
         // Construct skeleton of new level.
         //
 
+        double t0 = amrex::second();
+
         if (loadbalance_with_workestimates && !initial) {
             new_dmap[lev] = makeLoadBalanceDistributionMap(lev, time, new_grid_places[lev]);
         }
         else if (new_dmap[lev].empty()) {
-            new_dmap[lev].define(new_grid_places[lev]);
+            if (incrementalRegrid() && !initial && amr_level[lev]) {
+                new_dmap[lev] = MakeIncrementalDistributionMap(lev, new_grid_places[lev]);
+            } else {
+                new_dmap[lev].define(new_grid_places[lev]);
+            }
+        }
+
+        t_dmap += amrex::second() - t0;
+
+        if (record_regrid_info && !initial && amr_level[lev] && ParallelDescriptor::IOProcessor())
+        {
+            bytes_moved += bytes_per_cell * regrid_cells_moved(amr_level[lev]->boxArray(),
+                                                               amr_level[lev]->DistributionMap(),
+                                                               new_grid_places[lev],
+                                                               new_dmap[lev]);
         }
 
+        t0 = amrex::second();
+
         AmrLevel* a = (*levelbld)(*this,lev,Geom(lev),new_grid_places[lev],
                                   new_dmap[lev],cumtime);
 
@@ -2659,6 +2843,7 @@ Amr::regrid (int  lbase,
             this->SetDistributionMap(lev, amr_level[lev]->DistributionMap());
         }
 
+        t_init += amrex::second() - t0;
     }
 
 
@@ -2666,10 +2851,15 @@ Amr::regrid (int  lbase,
     // Check at *all* levels whether we need to do anything special now that the grids
     //       at levels lbase+1 and higher may have changed.
     //
+    const double t_post_regrid = amrex::second();
     for(int lev(0); lev <= new_finest; ++lev) {
         amr_level[lev]->post_regrid(lbase,new_finest);
     }
 
+    if (record_regrid_info) {
+        record_regrid(true, amrex::second() - t_post_regrid);
+    }
+
     //
     // Report creation of new grids.
     //
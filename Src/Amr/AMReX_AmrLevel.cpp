@@ -425,6 +425,7 @@ AmrLevel::restart (Amr&          papa,
     }
 
     dmap.define(grids);
+    m_fillpatcher.clear();
 
     parent->SetBoxArray(level, grids);
     parent->SetDistributionMap(level, dmap);
@@ -1006,7 +1007,21 @@ FillPatchIterator::Initialize (int  boxGrow,
     const IndexType& boxType = m_leveldata.boxArray().ixType();
     const int level = m_amrlevel.level;
 
-    for (int i = 0, DComp = 0; i < static_cast<int>(m_range.size()); i++)
+    bool use_plans = level > 0 && Amr::UseFillPatchPlans();
+    for (int i = 0; use_plans && i < static_cast<int>(m_range.size()); i++)
+    {
+        use_plans = level == 1 ||
+            amrex::ProperlyNested(m_amrlevel.crse_ratio,
+                                  m_amrlevel.parent->blockingFactor(m_amrlevel.level),
+                                  boxGrow, boxType, desc.interp(m_range[i].first));
+    }
+
+    if (use_plans)
+    {
+        FillFromTwoLevelsWithPlans(time, idx, scomp, ncomp);
+    }
+
+    for (int i = 0, DComp = 0; !use_plans && i < static_cast<int>(m_range.size()); i++)
     {
         const int SComp = m_range[i].first;
         const int NComp = m_range[i].second;
@@ -1149,6 +1164,125 @@ FillPatchIterator::FillFromTwoLevels (Real time, int idx, int scomp, int dcomp,
                               desc.getBCs(),scomp);
 }
 
+void
+FillPatchIterator::FillFromTwoLevelsWithPlans (Real time, int idx, int scomp, int ncomp)
+{
+    BL_PROFILE("FillPatchIterator::FillFromTwoLevelsWithPlans()");
+
+    int ilev_fine = m_amrlevel.level;
+    int ilev_crse = ilev_fine-1;
+
+    BL_ASSERT(ilev_crse >= 0);
+
+    AmrLevel& fine_level = m_amrlevel;
+    AmrLevel& crse_level = m_amrlevel.parent->getLevel(ilev_crse);
+
+    const Geometry& geom_fine = fine_level.geom;
+    const Geometry& geom_crse = crse_level.geom;
+
+    Vector<MultiFab*> smf_crse;
+    Vector<Real> stime_crse;
+    StateData& statedata_crse = crse_level.state[idx];
+    statedata_crse.getData(smf_crse,stime_crse,time);
+
+    Vector<MultiFab*> smf_fine;
+    Vector<Real> stime_fine;
+    StateData& statedata_fine = fine_level.state[idx];
+    statedata_fine.getData(smf_fine,stime_fine,time);
+
+    const StateDescriptor& desc = AmrLevel::desc_lst[idx];
+    const IntVect& nghost = m_fabs.nGrowVect();
+    const int nranges = static_cast<int>(m_range.size());
+
+    Vector<FillPatcher<MultiFab>*> plans(nranges);
+    for (int i = 0; i < nranges; ++i) {
+        plans[i] = &fine_level.getFillPatcher(m_fabs, idx, nghost,
+                                              desc.interp(m_range[i].first),
+                                              m_range[i].second);
+    }
+
+    //
+    // The fine data of all the ranges are exchanged at once, while the
+    // coarse data of each range are fetched and interpolated.
+    //
+    plans[0]->fetchCoarse_nowait(time, smf_crse, stime_crse,
+                                 m_range[0].first, m_range[0].second);
+
+    const bool local_fine = FillPatcher<MultiFab>::fillFineValid(m_fabs, time, smf_fine, stime_fine,
+                                                                 scomp, 0, ncomp);
+    const bool overlap = local_fine && !geom_fine.isAnyPeriodic();
+    if (overlap) {
+        m_fabs.FillBoundary_nowait(0, ncomp, nghost, geom_fine.periodicity());
+    }
+
+    for (int i = 0, DComp = 0; i < nranges; ++i)
+    {
+        const int SComp = m_range[i].first;
+        const int NComp = m_range[i].second;
+        if (i > 0) {
+            plans[i]->fetchCoarse_nowait(time, smf_crse, stime_crse, SComp, NComp);
+        }
+        StateDataPhysBCFunct physbcf_crse(statedata_crse,SComp,geom_crse);
+        plans[i]->interpFromCoarse(m_fabs, time, DComp, NComp, physbcf_crse, SComp,
+                                   desc.getBCs(), SComp);
+        DComp += NComp;
+    }
+
+    if (overlap) {
+        m_fabs.FillBoundary_finish();
+    } else if (local_fine) {
+        m_fabs.FillBoundary(0, ncomp, nghost, geom_fine.periodicity());
+    }
+
+    for (int i = 0, DComp = 0; i < nranges; ++i)
+    {
+        const int SComp = m_range[i].first;
+        const int NComp = m_range[i].second;
+        StateDataPhysBCFunct physbcf_fine(statedata_fine,SComp,geom_fine);
+        if (local_fine) {
+            physbcf_fine(m_fabs, DComp, NComp, nghost, time, SComp);
+        } else {
+            amrex::FillPatchSingleLevel(m_fabs, nghost, time, smf_fine, stime_fine,
+                                        SComp, DComp, NComp, geom_fine, physbcf_fine, SComp);
+        }
+        DComp += NComp;
+    }
+}
+
+FillPatcher<MultiFab>&
+AmrLevel::getFillPatcher (const MultiFab& dst, int index, const IntVect& nghost,
+                          InterpBase* mapper, int ncomp)
+{
+    const MultiFab& fine = state[index].newData();
+    const FillPatcherKey key{index, dst.getBDKey(), fine.getBDKey()};
+    auto range = m_fillpatcher.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second->matches(dst, fine, nghost, mapper, ncomp)) {
+            return *it->second;
+        }
+    }
+
+    // The plans built for other grids of this state cannot be used again.
+    for (auto it = m_fillpatcher.begin(); it != m_fillpatcher.end(); ) {
+        if (std::get<0>(it->first) == index && std::get<2>(it->first) != std::get<2>(key)) {
+            it = m_fillpatcher.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+#ifdef AMREX_USE_EB
+    EB2::IndexSpace const* index_space = EB2::TopIndexSpaceIfPresent();
+#else
+    EB2::IndexSpace const* index_space = nullptr;
+#endif
+    AmrLevel& crse_level = parent->getLevel(level-1);
+    auto it = m_fillpatcher.emplace(key, std::make_unique<FillPatcher<MultiFab> >
+                                    (dst, fine, nghost, geom, crse_level.geom,
+                                     crse_level.fineRatio(), mapper, ncomp, index_space));
+    return *it->second;
+}
+
 static
 bool
 HasPhysBndry (const Box&      b,
@@ -1844,6 +1978,8 @@ AmrLevel::UpdateDistributionMaps ( DistributionMapping& update_dmap )
        if (state[i].DistributionMap().size() == mapsize)
           { state[i].setDistributionMap(update_dmap); }
     }
+
+    m_fillpatcher.clear();
 }
 
 
@@ -2113,6 +2249,91 @@ AmrLevel::FillPatch (AmrLevel& amrlevel,
     MultiFab::Copy(leveldata, mf_fillpatched, 0, dcomp, ncomp, boxGrow);
 }
 
+void
+AmrLevel::FillPatchIncremental (AmrLevel& old,
+                                MultiFab& leveldata,
+                                Real      time,
+                                int       index)
+{
+    BL_PROFILE("AmrLevel::FillPatchIncremental()");
+
+    const int ncomp = leveldata.nComp();
+    MultiFab& old_data = old.get_new_data(index);
+
+    const BoxArray& ba = leveldata.boxArray();
+    const DistributionMapping& dm = leveldata.DistributionMap();
+    const BoxArray& old_ba = old_data.boxArray();
+    const DistributionMapping& old_dm = old_data.DistributionMap();
+
+    bool can_move = old.get_state_data(index).curTime() == time
+        && old_data.nComp() == ncomp
+        && old_data.nGrowVect() == leveldata.nGrowVect()
+        && old_ba.ixType() == ba.ixType()
+        && old_data.arena() == leveldata.arena();
+#ifdef AMREX_USE_EB
+    if (EB2::TopIndexSpaceIfPresent()) {
+        can_move = false;
+    }
+#endif
+
+    //
+    // The old box with the same box and owner as each new box, or -1.
+    //
+    const int nboxes = static_cast<int>(ba.size());
+    Vector<int> old_index(nboxes, -1);
+    int nmoved = 0;
+    if (can_move) {
+        std::vector<std::pair<int,Box> > isects;
+        for (int i = 0; i < nboxes; ++i) {
+            old_ba.intersections(ba[i], isects);
+            for (auto const& is : isects) {
+                if (old_ba[is.first] == ba[i] && old_dm[is.first] == dm[i]) {
+                    old_index[i] = is.first;
+                    ++nmoved;
+                    break;
+                }
+            }
+        }
+    }
+
+    if (nmoved == 0) {
+        FillPatch(old, leveldata, 0, time, index, 0, ncomp);
+        return;
+    }
+
+    //
+    // FillPatch the new boxes while the old data are still in place.
+    // The FABs have the same shape as those of leveldata, so they can be
+    // swapped in afterwards.  swapFab, unlike swapping the FABs themselves,
+    // also drops the Array4s cached by arrays().
+    //
+    if (nmoved < nboxes) {
+        BoxList bl(ba.ixType());
+        Vector<int> pmap;
+        Vector<int> new_index;
+        for (int i = 0; i < nboxes; ++i) {
+            if (old_index[i] < 0) {
+                bl.push_back(ba[i]);
+                pmap.push_back(dm[i]);
+                new_index.push_back(i);
+            }
+        }
+        MultiFab mf(BoxArray(std::move(bl)), DistributionMapping(std::move(pmap)),
+                    ncomp, leveldata.nGrowVect(), MFInfo().SetArena(leveldata.arena()));
+        FillPatch(old, mf, 0, time, index, 0, ncomp);
+        for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+            leveldata.swapFab(new_index[mfi.index()], mf, mfi.index());
+        }
+    }
+
+    for (MFIter mfi(leveldata); mfi.isValid(); ++mfi) {
+        const int i = old_index[mfi.index()];
+        if (i >= 0) {
+            leveldata.swapFab(mfi.index(), old_data, i);
+        }
+    }
+}
+
 void
 AmrLevel::FillPatchAdd (AmrLevel& amrlevel,
                         MultiFab& leveldata,
@@ -107,7 +107,9 @@ AmrCore::regrid (int lbase, Real time, bool)
                 DistributionMapping level_dmap = dmap[lev];
                 if (ba_changed) {
                     level_grids = new_grids[lev];
-                    level_dmap = DistributionMapping(level_grids);
+                    level_dmap = incremental_regrid
+                        ? MakeIncrementalDistributionMap(lev, level_grids)
+                        : DistributionMapping(level_grids);
                 }
                 const auto old_num_setdm = num_setdm;
                 RemakeLevel(lev, time, level_grids, level_dmap);
@@ -139,6 +141,36 @@ AmrCore::regrid (int lbase, Real time, bool)
     finest_level = new_finest;
 }
 
+bool
+AmrCore::LoadBalance (int lev, Real time, const LayoutData<Real>& costs,
+                      Real hysteresis, bool use_sfc)
+{
+    BL_PROFILE("AmrCore::LoadBalance()");
+
+    AMREX_ALWAYS_ASSERT(lev >= 0 && lev <= finest_level);
+    AMREX_ALWAYS_ASSERT(costs.boxArray() == grids[lev] &&
+                        costs.DistributionMap() == dmap[lev]);
+
+    DistributionMapping new_dmap;
+    Real current_eff, proposed_eff;
+    if (!DistributionMapping::rebalance(costs, new_dmap, hysteresis, use_sfc,
+                                        current_eff, proposed_eff)) {
+        return false;
+    }
+
+    if (verbose > 0) {
+        amrex::Print() << "AmrCore::LoadBalance: level " << lev << " efficiency "
+                       << current_eff << " -> " << proposed_eff << "\n";
+    }
+
+    const auto old_num_setdm = num_setdm;
+    RemakeLevel(lev, time, grids[lev], new_dmap);
+    if (old_num_setdm == num_setdm) {
+        SetDistributionMap(lev, new_dmap);
+    }
+    return true;
+}
+
 
 void
 AmrCore::printGridSummary (std::ostream& os, int min_lev, int max_lev) const noexcept
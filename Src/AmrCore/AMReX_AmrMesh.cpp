@@ -5,6 +5,12 @@
 #include <AMReX_ParmParse.H>
 #include <AMReX_ParallelDescriptor.H>
 #include <AMReX_Print.H>
+#include <AMReX_Utility.H>
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
 
 namespace amrex {
 
@@ -105,6 +111,18 @@ AmrMesh::InitAmrMesh (int max_level_in, const Vector<int>& n_cell_in,
 
     pp.queryAdd("n_proper",n_proper);
     pp.queryAdd("grid_eff",grid_eff);
+    pp.queryAdd("distributed_clustering",distributed_clustering);
+    pp.queryAdd("incremental_regrid",incremental_regrid);
+    pp.queryAdd("grid_tune",grid_tune);
+    if (pp.countval("grid_tune_eff") > 0) {
+        Vector<Real> eff;
+        pp.getarr("grid_tune_eff",eff);
+        grid_tune_eff = eff;
+    }
+    pp.queryAdd("grid_tune_cell_cost",grid_tune_cell_cost);
+    pp.queryAdd("grid_tune_box_cost",grid_tune_box_cost);
+    pp.queryAdd("grid_tune_ghost_cost",grid_tune_ghost_cost);
+    pp.queryAdd("grid_tune_ngrow",grid_tune_ngrow);
     int cnt = pp.countval("n_error_buf");
     if (cnt > 0) {
         Vector<int> neb;
@@ -489,6 +507,60 @@ AmrMesh::MakeBaseGrids () const
     return ba;
 }
 
+DistributionMapping
+AmrMesh::MakeIncrementalDistributionMap (int lev, const BoxArray& ba) const
+{
+    BL_PROFILE("AmrMesh::MakeIncrementalDistributionMap()");
+
+    const BoxArray& old_ba = grids[lev];
+    const DistributionMapping& old_dm = dmap[lev];
+    if (old_ba.empty() || old_dm.empty()) {
+        return DistributionMapping(ba);
+    }
+
+    const int nprocs = ParallelContext::NProcsSub();
+    const int nboxes = static_cast<int>(ba.size());
+    Vector<int> pmap(nboxes, -1);
+    Vector<Long> load(nprocs, 0);
+    Vector<std::pair<Long,int> > new_boxes;
+
+    std::vector<std::pair<int,Box> > isects;
+    for (int i = 0; i < nboxes; ++i) {
+        const Box& bx = ba[i];
+        old_ba.intersections(bx, isects);
+        for (auto const& is : isects) {
+            if (old_ba[is.first] == bx) {
+                pmap[i] = old_dm[is.first];
+                break;
+            }
+        }
+        if (pmap[i] >= 0) {
+            load[pmap[i]] += bx.numPts();
+        } else {
+            new_boxes.emplace_back(bx.numPts(), i);
+        }
+    }
+
+    // Largest box first, to the least loaded process.
+    std::sort(new_boxes.begin(), new_boxes.end(),
+              [] (std::pair<Long,int> const& a, std::pair<Long,int> const& b)
+              { return (a.first > b.first) || (a.first == b.first && a.second < b.second); });
+    using LoadRank = std::pair<Long,int>;
+    std::priority_queue<LoadRank, std::vector<LoadRank>, std::greater<LoadRank> > procs;
+    for (int p = 0; p < nprocs; ++p) {
+        procs.emplace(load[p], p);
+    }
+    for (auto const& nb : new_boxes) {
+        LoadRank lr = procs.top();
+        procs.pop();
+        pmap[nb.second] = lr.second;
+        lr.first += nb.first;
+        procs.push(lr);
+    }
+
+    return DistributionMapping(std::move(pmap));
+}
+
 
 void
 AmrMesh::MakeNewGrids (int lbase, Real time, int& new_finest, Vector<BoxArray>& new_grids)
@@ -497,6 +569,8 @@ AmrMesh::MakeNewGrids (int lbase, Real time, int& new_finest, Vector<BoxArray>&
 
     BL_ASSERT(lbase < max_level);
 
+    mng_times = MakeNewGridsTimes();
+
     // Add at most one new level
     int max_crse = std::min(finest_level, max_level-1);
 
@@ -613,7 +687,9 @@ AmrMesh::MakeNewGrids (int lbase, Real time, int& new_finest, Vector<BoxArray>&
         //
 
         if ( ! (useFixedCoarseGrids() && levc < useFixedUpToLevel()) ) {
+            const double t0 = amrex::second();
             ErrorEst(levc, tags, time, 0);
+            mng_times.error_est += amrex::second() - t0;
         }
 
         //
@@ -674,11 +750,21 @@ AmrMesh::MakeNewGrids (int lbase, Real time, int& new_finest, Vector<BoxArray>&
         //
         // Create initial cluster containing all tagged points.
         //
+        const double t_collate = amrex::second();
         Gpu::PinnedVector<IntVect> tagvec;
-        tags.collate(tagvec);
+        Long ntags = 0;
+        if (distributed_clustering) {
+            tags.local_collate(tagvec);
+            ntags = tagvec.size();
+            ParallelDescriptor::ReduceLongSum(ntags);
+        } else {
+            tags.collate(tagvec);
+            ntags = tagvec.size();
+        }
         tags.clear();
+        mng_times.collate += amrex::second() - t_collate;
 
-        if (tagvec.size() > 0)
+        if (ntags > 0)
         {
             //
             // Created new level, now generate efficient grids.
@@ -688,33 +774,62 @@ AmrMesh::MakeNewGrids (int lbase, Real time, int& new_finest, Vector<BoxArray>&
             }
 
             if (levf > useFixedUpToLevel()) {
+                //
+                // Cluster the tags with efficiency eff and return the new
+                // grids on level levc.
+                //
+                auto cluster = [&] (Real eff) -> BoxList
+                {
+                    BoxList cbl;
+                    if (distributed_clustering) {
+                        cbl = ClusterDistributed(tagvec.data(), tagvec.size(), eff,
+                                                 use_new_chop, p_n_ba[levc]);
+                    } else {
+                        //
+                        // Construct initial cluster.
+                        //
+                        ClusterList clist(&tagvec[0], tagvec.size());
+                        if (use_new_chop) {
+                            clist.new_chop(eff);
+                        } else {
+                            clist.chop(eff);
+                        }
+                        BoxArray domba = p_n_ba[levc]; // intersect clears it
+                        clist.intersect(domba);
+                        //
+                        // Efficient properly nested Clusters have been constructed
+                        // now generate list of grids at level levf.
+                        //
+                        clist.boxList(cbl);
+                    }
+                    cbl.refine(bf_lev[levc]);
+                    cbl.simplify();
+
+                    if (cbl.size()>0) {
+                        // Chop new grids outside domain
+                        cbl.intersect(Geom(levc).Domain());
+                    }
+                    return cbl;
+                };
+
+                const double t_cluster = amrex::second();
                 BoxList new_bx;
-                if (ParallelDescriptor::IOProcessor()) {
+                IntVect mgs = max_grid_size[levf];
+                if (distributed_clustering || ParallelDescriptor::IOProcessor()) {
                     BL_PROFILE("AmrMesh-cluster");
-                    //
-                    // Construct initial cluster.
-                    //
-                    ClusterList clist(&tagvec[0], tagvec.size());
-                    if (use_new_chop) {
-                        clist.new_chop(grid_eff);
+                    if (grid_tune) {
+                        new_bx = TuneNewGrids(levf, cluster, mgs);
                     } else {
-                        clist.chop(grid_eff);
+                        new_bx = cluster(grid_eff);
                     }
-                    clist.intersect(p_n_ba[levc]);
-                    //
-                    // Efficient properly nested Clusters have been constructed
-                    // now generate list of grids at level levf.
-                    //
-                    clist.boxList(new_bx);
-                    new_bx.refine(bf_lev[levc]);
-                    new_bx.simplify();
-
-                    if (new_bx.size()>0) {
-                        // Chop new grids outside domain
-                        new_bx.intersect(Geom(levc).Domain());
+                }
+                if (!distributed_clustering) {
+                    new_bx.Bcast();  // Broadcast the new BoxList to other processes
+                    if (grid_tune) {
+                        ParallelDescriptor::Bcast(mgs.begin(), AMREX_SPACEDIM,
+                                                  ParallelDescriptor::IOProcessorNumber());
                     }
                 }
-                new_bx.Bcast();  // Broadcast the new BoxList to other processes
 
                 //
                 // Refine up to levf.
@@ -722,7 +837,8 @@ AmrMesh::MakeNewGrids (int lbase, Real time, int& new_finest, Vector<BoxArray>&
                 new_bx.refine(ref_ratio[levc]);
                 BL_ASSERT(new_bx.isDisjoint());
 
-                new_grids[levf] = BoxArray(std::move(new_bx), max_grid_size[levf]);
+                new_grids[levf] = BoxArray(std::move(new_bx), mgs);
+                mng_times.cluster += amrex::second() - t_cluster;
             }
         }
     }
@@ -764,6 +880,102 @@ AmrMesh::MakeNewGrids (int lbase, Real time, int& new_finest, Vector<BoxArray>&
     }
 }
 
+BoxList
+AmrMesh::TuneNewGrids (int levf, std::function<BoxList(Real)> const& cluster,
+                       IntVect& mgs) const
+{
+    BL_PROFILE("AmrMesh::TuneNewGrids()");
+
+    const int levc = levf-1;
+
+    Vector<Real> effs = grid_tune_eff;
+    if (effs.empty()) {
+        effs.push_back(grid_eff);
+    }
+
+    BoxList best_bl;
+    Real best_cost = std::numeric_limits<Real>::max();
+    Real best_eff = grid_eff;
+    Long best_cells = 0;
+    Long best_boxes = 0;
+    bool tuned = false;
+    mgs = max_grid_size[levf];
+
+    for (Real eff : effs)
+    {
+        BoxList bl = cluster(eff);
+        BoxList fbl = bl;
+        fbl.refine(ref_ratio[levc]);
+
+        for (int fac = 1; fac <= 4; fac *= 2)
+        {
+            IntVect trial_mgs = max_grid_size[levf] / fac;
+            bool ok = true;
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                if (trial_mgs[idim] < blocking_factor[levf][idim] ||
+                    trial_mgs[idim] % blocking_factor[levf][idim] != 0) {
+                    ok = false;
+                }
+            }
+            if (!ok) { break; }
+
+            BoxArray ba(BoxList(fbl), trial_mgs);
+            if (refine_grid_layout) {
+                ChopGrids(levf, ba, ParallelDescriptor::NProcs());
+            }
+
+            const Long ncells = ba.numPts();
+            const Long nboxes = ba.size();
+            Long nghost = 0;
+            for (Long i = 0; i < nboxes; ++i) {
+                const Box& bx = ba[i];
+                nghost += amrex::grow(bx,grid_tune_ngrow).numPts() - bx.numPts();
+            }
+            const Real cost = grid_tune_cell_cost  * static_cast<Real>(ncells)
+                +             grid_tune_box_cost   * static_cast<Real>(nboxes)
+                +             grid_tune_ghost_cost * static_cast<Real>(nghost);
+
+            if (verbose > 1) {
+                amrex::Print() << "AmrMesh::TuneNewGrids: level " << levf
+                               << " grid_eff = " << eff << " max_grid_size = " << trial_mgs
+                               << " : " << nboxes << " boxes, " << ncells << " cells, "
+                               << nghost << " ghost cells, cost = " << cost << "\n";
+            }
+
+            if (cost < best_cost) {
+                tuned = true;
+                best_cost = cost;
+                best_eff = eff;
+                best_cells = ncells;
+                best_boxes = nboxes;
+                best_bl = bl;
+                mgs = trial_mgs;
+            }
+        }
+    }
+
+    if (!tuned) {
+        //
+        // No max_grid_size could be tried, because max_grid_size is not a
+        // multiple of the blocking factor.  Make the grids without tuning.
+        //
+        if (verbose > 0) {
+            amrex::Print() << "AmrMesh::TuneNewGrids: level " << levf
+                           << " has no valid max_grid_size to try, not tuning\n";
+        }
+        mgs = max_grid_size[levf];
+        return cluster(grid_eff);
+    }
+
+    if (verbose > 0) {
+        amrex::Print() << "AmrMesh::TuneNewGrids: level " << levf
+                       << " uses grid_eff = " << best_eff << " and max_grid_size = " << mgs
+                       << " : " << best_boxes << " boxes, " << best_cells << " cells\n";
+    }
+
+    return best_bl;
+}
+
 void
 AmrMesh::MakeNewGrids (Real time)
 {
@@ -1038,6 +1250,9 @@ std::ostream& operator<< (std::ostream& os, AmrMesh const& amr_mesh)
     os << "  check_input = " << amr_mesh.check_input  << "\n";
     os << "  use_new_chop = " << amr_mesh.use_new_chop << "\n";
     os << "  iterate_on_new_grids = " << amr_mesh.iterate_on_new_grids << "\n";
+    os << "  distributed_clustering = " << amr_mesh.distributed_clustering << "\n";
+    os << "  incremental_regrid = " << amr_mesh.incremental_regrid << "\n";
+    os << "  grid_tune = " << amr_mesh.grid_tune << "\n";
     return os;
 }
 
@@ -5,6 +5,7 @@
 #include <AMReX_Vector.H>
 #include <AMReX_Array.H>
 #include <AMReX_BLProfiler.H>
+#include <AMReX_ParallelDescriptor.H>
 
 #include <algorithm>
 #include <cmath>
@@ -604,4 +605,39 @@ ClusterList::intersect (BoxArray& domba)
     domba.clear();
 }
 
+BoxList
+ClusterDistributed (IntVect* tags, Long ntags, Real eff, bool use_new_chop, BoxArray domba)
+{
+    BL_PROFILE("ClusterDistributed()");
+
+    Vector<Box> bxs;
+    if (ntags > 0)
+    {
+        ClusterList clist(tags, ntags);
+        if (use_new_chop) {
+            clist.new_chop(eff);
+        } else {
+            clist.chop(eff);
+        }
+        clist.intersect(domba);
+        BoxList bl;
+        clist.boxList(bl);
+        bxs = std::move(bl.data());
+    }
+
+    amrex::AllGatherBoxes(bxs);
+
+    if (bxs.empty()) return BoxList();
+
+    //
+    // The clusters of different processes may overlap, because each of
+    // them only covers the tags of one process.  The gathered boxes are in
+    // the same order on all processes, so all of them end up with the same
+    // disjoint and simplified boxes.
+    //
+    BoxArray ba(BoxList(std::move(bxs)));
+    ba.removeOverlap();
+    return ba.boxList();
+}
+
 }
@@ -88,10 +88,19 @@ FluxRegister::define (const BoxArray&            fine_boxes,
 void
 FluxRegister::clear ()
 {
+    SendToCrse_finish();
+    for (auto& mf : m_crse_flux) {
+        mf.clear();
+    }
+    m_sent = false;
+    m_refluxed = false;
     BndryRegister::clear();
 }
 
-FluxRegister::~FluxRegister () {}
+FluxRegister::~FluxRegister ()
+{
+    SendToCrse_finish();
+}
 
 Real
 FluxRegister::SumReg (int comp) const
@@ -171,6 +180,16 @@ FluxRegister::CrseInit (const MultiFab& mflx,
     BL_ASSERT(srccomp >= 0 && srccomp+numcomp <= mflx.nComp());
     BL_ASSERT(destcomp >= 0 && destcomp+numcomp <= ncomp);
 
+    if (m_sent) {
+        if (m_refluxed) {
+            // A new coarse step
+            m_sent = false;
+            m_refluxed = false;
+        } else if (op == FluxRegister::COPY) {
+            amrex::Abort("FluxRegister::CrseInit: COPY is not allowed between SendToCrse_nowait and Reflux");
+        }
+    }
+
     const Orientation face_lo(dir,Orientation::low);
     const Orientation face_hi(dir,Orientation::high);
 
@@ -600,11 +619,30 @@ FluxRegister::Reflux (MultiFab& mf, const MultiFab& volume, Orientation face,
 
     int idir = face.coordDir();
 
-    MultiFab flux(amrex::convert(mf.boxArray(), IntVect::TheDimensionVector(idir)),
-                  mf.DistributionMap(), nc, 0, MFInfo(), mf.Factory());
-    flux.setVal(0.0);
+    MultiFab flux;
+    if (m_sent)
+    {
+        SendToCrse_finish();
+
+        MultiFab& crse_flux = m_crse_flux[face];
+        AMREX_ALWAYS_ASSERT(crse_flux.boxArray().CellEqual(mf.boxArray()) &&
+                            crse_flux.DistributionMap() == mf.DistributionMap());
 
-    bndry[face].copyTo(flux, 0, scomp, 0, nc, geom.periodicity());
+        // What was added to the register after the last SendToCrse_nowait
+        bndry[face].plusTo(crse_flux, 0, 0, 0, ncomp, geom.periodicity());
+        bndry[face].setVal(0.0);
+        m_refluxed = true;
+
+        flux = MultiFab(crse_flux, amrex::make_alias, scomp, nc);
+    }
+    else
+    {
+        flux.define(amrex::convert(mf.boxArray(), IntVect::TheDimensionVector(idir)),
+                    mf.DistributionMap(), nc, 0, MFInfo(), mf.Factory());
+        flux.setVal(0.0);
+
+        bndry[face].copyTo(flux, 0, scomp, 0, nc, geom.periodicity());
+    }
 
 #ifdef AMREX_USE_GPU
     if (Gpu::inLaunchRegion() && mf.isFusingCandidate()) {
@@ -642,6 +680,58 @@ FluxRegister::Reflux (MultiFab& mf, const MultiFab& volume, Orientation face,
     }
 }
 
+void
+FluxRegister::SendToCrse_nowait (const MultiFab& crse_mf, const Geometry& crse_geom)
+{
+    BL_PROFILE("FluxRegister::SendToCrse_nowait()");
+
+    SendToCrse_finish();
+
+    if (!m_sent || m_refluxed)
+    {
+        for (OrientationIter fi; fi; ++fi)
+        {
+            const Orientation face = fi();
+            MultiFab& crse_flux = m_crse_flux[face];
+            const BoxArray& ba = amrex::convert(crse_mf.boxArray(),
+                                                IntVect::TheDimensionVector(face.coordDir()));
+            if (crse_flux.nComp() != ncomp || crse_flux.boxArray() != ba ||
+                crse_flux.DistributionMap() != crse_mf.DistributionMap())
+            {
+                crse_flux = MultiFab(ba, crse_mf.DistributionMap(), ncomp, 0,
+                                     MFInfo(), crse_mf.Factory());
+            }
+            crse_flux.setVal(0.0);
+        }
+        m_sent = true;
+        m_refluxed = false;
+    }
+
+    // The send buffers are packed and the local data are added before
+    // ParallelAdd_nowait returns, so the register can be cleared.
+    for (OrientationIter fi; fi; ++fi)
+    {
+        const Orientation face = fi();
+        m_crse_flux[face].ParallelAdd_nowait(bndry[face].multiFab(), 0, 0, ncomp,
+                                             crse_geom.periodicity());
+        bndry[face].setVal(0.0);
+    }
+    m_sending = true;
+}
+
+void
+FluxRegister::SendToCrse_finish ()
+{
+    if (m_sending)
+    {
+        BL_PROFILE("FluxRegister::SendToCrse_finish()");
+        for (auto& mf : m_crse_flux) {
+            mf.ParallelCopy_finish();
+        }
+        m_sending = false;
+    }
+}
+
 void
 FluxRegister::ClearInternalBorders (const Geometry& geom)
 {
@@ -529,11 +529,16 @@ CellConservativeLinear::interp (const FArrayBox& crse,
             });
         }
 
-        AMREX_HOST_DEVICE_PARALLEL_FOR_4D_FLAG(runon, fine_region, ncomp, i, j, k, n,
-        {
-            mf_cell_cons_lin_interp(i,j,k,n, finearr, fine_comp, ctmp,
-                                    crsearr, crse_comp, ncomp, ratio);
-        });
+        if (run_on_gpu) {
+            AMREX_HOST_DEVICE_PARALLEL_FOR_4D_FLAG(runon, fine_region, ncomp, i, j, k, n,
+            {
+                mf_cell_cons_lin_interp(i,j,k,n, finearr, fine_comp, ctmp,
+                                        crsearr, crse_comp, ncomp, ratio);
+            });
+        } else {
+            mf_cell_cons_lin_interp_cpu(fine_region, ncomp, finearr, fine_comp, ctmp,
+                                        crsearr, crse_comp, ratio);
+        }
     }
 }
 
@@ -203,17 +203,19 @@ MFCellConsLinInterp::interp (MultiFab const& crsemf, int ccomp, MultiFab& finemf
 #endif
         {
             FArrayBox tmpfab;
-            for (MFIter mfi(finemf); mfi.isValid(); ++mfi) {
+            for (MFIter mfi(finemf, true); mfi.isValid(); ++mfi) {
+                Box const& fbox = mfi.growntilebox(ng) & dest_domain;
+                if (!fbox.ok()) { continue; }
+
                 auto const& fine = finemf.array(mfi);
                 auto const& crse = crsemf.const_array(mfi);
 
-                Box const& cbox = amrex::grow(crsemf[mfi].box(), -1);
+                // Slopes are only needed on the coarse cells under this tile.
+                Box const& cbox = amrex::coarsen(fbox, ratio);
                 tmpfab.resize(cbox, AMREX_SPACEDIM*nc);
                 auto const& tmp = tmpfab.array();
                 auto const& ctmp = tmpfab.const_array();
 
-                Box const& fbox = amrex::grow(mfi.validbox(), ng) & dest_domain;
-
 #if (AMREX_SPACEDIM == 1)
                 if (cgeom.IsSPHERICAL()) {
                     Real drf = fgeom.CellSize(0);
@@ -286,12 +288,7 @@ MFCellConsLinInterp::interp (MultiFab const& crsemf, int ccomp, MultiFab& finemf
                         });
                     }
 
-                    amrex::LoopConcurrentOnCpu(fbox, nc,
-                    [&] (int i, int j, int k, int n) noexcept
-                    {
-                        mf_cell_cons_lin_interp(i,j,k,n, fine, fcomp, ctmp,
-                                                crse, ccomp, nc, ratio);
-                    });
+                    mf_cell_cons_lin_interp_cpu(fbox, nc, fine, fcomp, ctmp, crse, ccomp, ratio);
                 }
             }
         }
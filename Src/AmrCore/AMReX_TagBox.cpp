@@ -587,23 +587,151 @@ TagBoxArray::local_collate_gpu (Gpu::PinnedVector<IntVect>& v) const
 
     v.resize(ntotaltags);
     Gpu::dtoh_memcpy(v.data(), dp_tags, ntotaltags*sizeof(IntVect));
+
+    // The atomic counter puts the tags of each block in an arbitrary order.
+    // Sort them into the order of the cells, so that the list is the same
+    // as the one local_collate_cpu makes and does not change between runs.
+    for (int ib = 0; ib < ntotblocks; ++ib) {
+        std::sort(v.begin()+hv_tags_offset[ib], v.begin()+hv_tags_offset[ib+1],
+                  [] (IntVect const& a, IntVect const& b) -> bool
+                  {
+                      for (int idim = AMREX_SPACEDIM-1; idim >= 0; --idim) {
+                          if (a[idim] != b[idim]) { return a[idim] < b[idim]; }
+                      }
+                      return false;
+                  });
+    }
 }
 #endif
 
 void
-TagBoxArray::collate (Gpu::PinnedVector<IntVect>& TheGlobalCollateSpace) const
+TagBoxArray::local_collate (Gpu::PinnedVector<IntVect>& v) const
 {
-    BL_PROFILE("TagBoxArray::collate()");
-
-    Gpu::PinnedVector<IntVect> TheLocalCollateSpace;
 #ifdef AMREX_USE_GPU
     if (Gpu::inLaunchRegion()) {
-        local_collate_gpu(TheLocalCollateSpace);
+        local_collate_gpu(v);
     } else
 #endif
     {
-        local_collate_cpu(TheLocalCollateSpace);
+        local_collate_cpu(v);
     }
+}
+
+namespace detail {
+
+//
+// The encoding of a list of tags used by TagBoxArray::collate.  A list is
+// stored either as a bit mask over the bounding box of the tags,
+//
+//     0, bbox.smallEnd, bbox.bigEnd, ceil(bbox.numPts()/32) words of bits
+//
+// or as runs of consecutive cells in the first direction,
+//
+//     1, number of runs, (first cell of the run, length of the run) ...
+//
+// whichever is shorter.
+//
+constexpr int tag_mask_encoding = 0;
+constexpr int tag_runs_encoding = 1;
+
+void
+encode_tags (const IntVect* tags, Long ntags, Vector<int>& buf)
+{
+    if (ntags <= 0) return;
+
+    IntVect lo = tags[0];
+    IntVect hi = tags[0];
+    Long nruns = 1;
+    for (Long n = 1; n < ntags; ++n) {
+        lo.min(tags[n]);
+        hi.max(tags[n]);
+        if (tags[n] - tags[n-1] != IntVect::TheDimensionVector(0)) {
+            ++nruns;
+        }
+    }
+
+    const Box bbox(lo, hi);
+    const Long nwords = (bbox.numPts() + 31) / 32;
+    const Long mask_size = 1 + 2*AMREX_SPACEDIM + nwords;
+    const Long runs_size = 2 + (AMREX_SPACEDIM+1)*nruns;
+
+    if (mask_size < runs_size) {
+        buf.push_back(tag_mask_encoding);
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) { buf.push_back(lo[idim]); }
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) { buf.push_back(hi[idim]); }
+        const Long start = buf.size();
+        buf.resize(start+nwords, 0);
+        for (Long n = 0; n < ntags; ++n) {
+            const Long offset = bbox.index(tags[n]);
+            auto& w = buf[start + offset/32];
+            w = static_cast<int>(static_cast<unsigned int>(w) | (1u << (offset%32)));
+        }
+    } else {
+        buf.push_back(tag_runs_encoding);
+        buf.push_back(static_cast<int>(nruns));
+        int len = 0;
+        for (Long n = 0; n < ntags; ++n) {
+            if (n == 0 || tags[n] - tags[n-1] != IntVect::TheDimensionVector(0)) {
+                if (n > 0) { buf.push_back(len); }
+                for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) { buf.push_back(tags[n][idim]); }
+                len = 0;
+            }
+            ++len;
+        }
+        buf.push_back(len);
+    }
+}
+
+void
+decode_tags (Vector<int> const& buf, Gpu::PinnedVector<IntVect>& tags)
+{
+    const int* p = buf.data();
+    const int* pend = p + buf.size();
+    while (p < pend)
+    {
+        const int encoding = *p++;
+        if (encoding == tag_mask_encoding) {
+            IntVect lo(p);
+            IntVect hi(p+AMREX_SPACEDIM);
+            p += 2*AMREX_SPACEDIM;
+            const Box bbox(lo, hi);
+            const Long npts = bbox.numPts();
+            const Long nwords = (npts + 31) / 32;
+            for (Long iw = 0; iw < nwords; ++iw) {
+                const auto w = static_cast<unsigned int>(p[iw]);
+                if (w == 0) continue;
+                for (int ib = 0; ib < 32; ++ib) {
+                    if (w & (1u << ib)) {
+                        tags.push_back(bbox.atOffset(iw*32+ib));
+                    }
+                }
+            }
+            p += nwords;
+        } else {
+            AMREX_ASSERT(encoding == tag_runs_encoding);
+            const int nruns = *p++;
+            for (int irun = 0; irun < nruns; ++irun) {
+                IntVect iv(p);
+                const int len = p[AMREX_SPACEDIM];
+                p += AMREX_SPACEDIM+1;
+                for (int i = 0; i < len; ++i) {
+                    tags.push_back(iv);
+                    ++iv[0];
+                }
+            }
+        }
+    }
+}
+
+}
+
+void
+TagBoxArray::collate (Gpu::PinnedVector<IntVect>& TheGlobalCollateSpace) const
+{
+    BL_PROFILE("TagBoxArray::collate()");
+
+    Gpu::PinnedVector<IntVect> TheLocalCollateSpace;
+    local_collate(TheLocalCollateSpace);
 
     Long count = TheLocalCollateSpace.size();
 
@@ -616,40 +744,72 @@ TagBoxArray::collate (Gpu::PinnedVector<IntVect>& TheGlobalCollateSpace) const
     if (numtags == 0) {
         TheGlobalCollateSpace.clear();
         return;
-    } else if (numtags > static_cast<Long>(std::numeric_limits<int>::max())) {
-        // xxxxx todo
-        amrex::Abort("TagBoxArray::collate: Too many tags. Using a larger blocking factor might help. Please file an issue on github");
     }
 
 #ifdef BL_USE_MPI
     //
-    // On I/O proc. this holds all tags after they've been gather'd.
-    // On other procs. non-mempty signals size is not zero.
+    // The tags are sent in compressed form, one chunk per fab.  Within a
+    // fab local_collate returns the tags in the order of the cells, on the
+    // CPU and the GPU alike, so the chunks are decoded into exactly the same
+    // list as the uncompressed one.
     //
-    if (ParallelDescriptor::IOProcessor()) {
-        TheGlobalCollateSpace.resize(numtags);
-    } else {
-        TheGlobalCollateSpace.resize(1);
+    Vector<int> sendbuf;
+    {
+        const IntVect* p = TheLocalCollateSpace.data();
+        const IntVect* pend = p + count;
+        for (MFIter fai(*this); fai.isValid() && p < pend; ++fai)
+        {
+            Box const& bx = fai.fabbox();
+            const IntVect* q = p;
+            while (q < pend && bx.contains(*q)) { ++q; }
+            detail::encode_tags(p, q-p, sendbuf);
+            p = q;
+        }
+        // Should not happen, but we do not want to lose any tags.
+        detail::encode_tags(p, pend-p, sendbuf);
+    }
+
+    Long bufsize = sendbuf.size();
+    ParallelDescriptor::ReduceLongSum(bufsize, ParallelDescriptor::IOProcessorNumber());
+    if (ParallelDescriptor::IOProcessor() &&
+        bufsize > static_cast<Long>(std::numeric_limits<int>::max())) {
+        // xxxxx todo
+        amrex::Abort("TagBoxArray::collate: Too many tags. Using a larger blocking factor might help. Please file an issue on github");
     }
 
     //
-    // Tell root CPU how many tags each CPU will be sending.
+    // Tell root CPU how long the message of each CPU will be.
     //
     const int IOProcNumber = ParallelDescriptor::IOProcessorNumber();
-    const std::vector<int>& countvec = ParallelDescriptor::Gather(static_cast<int>(count),
+    const std::vector<int>& countvec = ParallelDescriptor::Gather(static_cast<int>(sendbuf.size()),
                                                                   IOProcNumber);
     std::vector<int> offset(countvec.size(),0);
+    Vector<int> recvbuf;
     if (ParallelDescriptor::IOProcessor()) {
         for (int i = 1, N = offset.size(); i < N; i++) {
             offset[i] = offset[i-1] + countvec[i-1];
         }
+        recvbuf.resize(bufsize);
     }
     //
-    // Gather all the tags to IOProcNumber into TheGlobalCollateSpace.
+    // Gather all the encoded tags to IOProcNumber.
+    //
+    const int* psend = sendbuf.empty() ? nullptr : sendbuf.data();
+    ParallelDescriptor::Gatherv(psend, static_cast<int>(sendbuf.size()), recvbuf.data(),
+                                countvec, offset, IOProcNumber);
+
+    //
+    // On I/O proc. this holds all tags after they've been gather'd.
+    // On other procs. non-mempty signals size is not zero.
     //
-    const IntVect* psend = (count > 0) ? TheLocalCollateSpace.data() : nullptr;
-    IntVect* precv = TheGlobalCollateSpace.data();
-    ParallelDescriptor::Gatherv(psend, count, precv, countvec, offset, IOProcNumber);
+    if (ParallelDescriptor::IOProcessor()) {
+        TheGlobalCollateSpace.clear();
+        TheGlobalCollateSpace.reserve(numtags);
+        detail::decode_tags(recvbuf, TheGlobalCollateSpace);
+        AMREX_ASSERT(static_cast<Long>(TheGlobalCollateSpace.size()) == numtags);
+    } else {
+        TheGlobalCollateSpace.resize(1);
+    }
 
 #else
     TheGlobalCollateSpace = std::move(TheLocalCollateSpace);
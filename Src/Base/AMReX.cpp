@@ -35,6 +35,10 @@
 #include <AMReX_EB2.H>
 #endif
 
+#ifdef AMREX_PARTICLES
+#include <AMReX_ParticleArena.H>
+#endif
+
 #ifndef BL_AMRPROF
 #include <AMReX_ParmParse.H>
 #include <AMReX_MultiFab.H>
@@ -496,6 +500,9 @@ amrex::Initialize (int& argc, char**& argv, bool build_parm_parse,
 
     Arena::Initialize();
     amrex_mempool_init();
+#ifdef AMREX_PARTICLES
+    ParticleArena_Initialize();
+#endif
 
     //
     // Initialize random seed after we're running in parallel.
@@ -1754,6 +1754,49 @@ DistributionMapping::makeSFC (const LayoutData<Real>& rcost_local,
     return r;
 }
 
+bool
+DistributionMapping::rebalance (const LayoutData<Real>& rcost_local, DistributionMapping& new_dm,
+                                Real hysteresis, bool use_sfc,
+                                Real& currentEfficiency, Real& proposedEfficiency)
+{
+    BL_PROFILE("DistributionMapping::rebalance()");
+
+    const int root = ParallelDescriptor::IOProcessorNumber();
+
+    // The efficiencies are only known on root.
+    DistributionMapping r = use_sfc
+        ? makeSFC(rcost_local, currentEfficiency, proposedEfficiency, false, root)
+        : makeKnapSack(rcost_local, currentEfficiency, proposedEfficiency,
+                       std::numeric_limits<int>::max(), false, root);
+
+    Real eff[2] = {currentEfficiency, proposedEfficiency};
+    ParallelDescriptor::Bcast(eff, 2, root);
+    currentEfficiency = eff[0];
+    proposedEfficiency = eff[1];
+
+    if (proposedEfficiency <= hysteresis*currentEfficiency) {
+        return false;
+    }
+
+    Vector<int> pmap(rcost_local.DistributionMap().size());
+    if (ParallelDescriptor::MyProc() == root)
+    {
+        pmap = r.ProcessorMap();
+    }
+    ParallelDescriptor::Bcast(pmap.data(), pmap.size(), root);
+    new_dm = DistributionMapping(std::move(pmap));
+    return true;
+}
+
+bool
+DistributionMapping::rebalance (const LayoutData<Real>& rcost_local, DistributionMapping& new_dm,
+                                Real hysteresis, bool use_sfc)
+{
+    Real currentEfficiency, proposedEfficiency;
+    return rebalance(rcost_local, new_dm, hysteresis, use_sfc,
+                     currentEfficiency, proposedEfficiency);
+}
+
 std::vector<std::vector<int> >
 DistributionMapping::makeSFC (const BoxArray& ba, bool use_box_vol, const int nprocs)
 {
@@ -2073,11 +2073,14 @@ FabArrayBase::CFinfo::CFinfo (const FabArrayBase& finefa,
                               const Geometry&     finegm,
                               const IntVect&      ng,
                               bool                include_periodic,
-                              bool                include_physbndry)
+                              bool                include_physbndry,
+                              bool                remove_periodic_images)
     : m_fine_bdk (finefa.getBDKey()),
+      m_fine_crse_ratio(finefa.boxArray().crseRatio()),
       m_ng       (ng),
       m_include_periodic(include_periodic),
       m_include_physbndry(include_physbndry),
+      m_remove_periodic_images(remove_periodic_images),
       m_nuse     (0)
 {
     BL_PROFILE("CFinfo::CFinfo()");
@@ -2087,6 +2090,11 @@ FabArrayBase::CFinfo::CFinfo (const FabArrayBase& finefa,
     const BoxArray& fba = amrex::convert(finefa.boxArray(), IndexType::TheCellType());
     const DistributionMapping& fdm = finefa.DistributionMap();
 
+    std::vector<IntVect> pshifts;
+    if (remove_periodic_images) {
+        pshifts = finegm.periodicity().shiftIntVect();
+    }
+
     BoxList bl(fba.ixType());
     Vector<int> iprocs;
     const int myproc = ParallelDescriptor::MyProc();
@@ -2097,7 +2105,17 @@ FabArrayBase::CFinfo::CFinfo (const FabArrayBase& finefa,
         bx.grow(m_ng);
         bx &= m_fine_domain;
 
-        const BoxList& noncovered = fba.complementIn(bx);
+        BoxList noncovered = fba.complementIn(bx);
+        for (const IntVect& iv : pshifts) {
+            if (iv == IntVect::TheZeroVector() || noncovered.isEmpty()) continue;
+            BoxList bl_iv(fba.ixType());
+            for (const Box& b : noncovered) {
+                for (const Box& b_iv : fba.complementIn(b-iv)) {
+                    bl_iv.push_back(b_iv+iv);
+                }
+            }
+            noncovered = std::move(bl_iv);
+        }
         for (const Box& b : noncovered) {
             bl.push_back(b);
             iprocs.push_back(fdm[i]);
@@ -2147,7 +2165,8 @@ FabArrayBase::TheCFinfo (const FabArrayBase& finefa,
                          const Geometry&     finegm,
                          const IntVect&      ng,
                          bool                include_periodic,
-                         bool                include_physbndry)
+                         bool                include_physbndry,
+                         bool                remove_periodic_images)
 {
     BL_PROFILE("FabArrayBase::TheCFinfo()");
 
@@ -2156,10 +2175,12 @@ FabArrayBase::TheCFinfo (const FabArrayBase& finefa,
     for (auto it = er_it.first; it != er_it.second; ++it)
     {
         if (it->second->m_fine_bdk    == key                        &&
+            it->second->m_fine_crse_ratio == finefa.boxArray().crseRatio() &&
             it->second->m_fine_domain == CFinfo::Domain(finegm, ng,
                                                         include_periodic,
                                                         include_physbndry) &&
-            it->second->m_ng          == ng)
+            it->second->m_ng          == ng                         &&
+            it->second->m_remove_periodic_images == remove_periodic_images)
         {
             ++(it->second->m_nuse);
             m_CFinfo_stats.recordUse();
@@ -2168,7 +2189,8 @@ FabArrayBase::TheCFinfo (const FabArrayBase& finefa,
     }
 
     // Have to build a new one
-    CFinfo* new_cfinfo = new CFinfo(finefa, finegm, ng, include_periodic, include_physbndry);
+    CFinfo* new_cfinfo = new CFinfo(finefa, finegm, ng, include_periodic, include_physbndry,
+                                    remove_periodic_images);
 
 #ifdef AMREX_MEM_PROFILING
     m_CFinfo_stats.bytes += new_cfinfo->bytes();
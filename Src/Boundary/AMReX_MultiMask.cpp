@@ -37,12 +37,7 @@ MultiMask::define (const BoxArray& regba, const DistributionMapping& dm, const G
         const int bndrydata_covered = BndryData::covered;
 
         int ngrow = std::max(out_rad, extent_rad);
-        Box domain = geom.Domain();
-        for (int i = 0; i < AMREX_SPACEDIM; ++i) {
-            if (geom.isPeriodic(i)) {
-                domain.grow(i, ngrow);
-            }
-        }
+        const Box& domain = FabArrayBase::CFinfo::Domain(geom, IntVect(ngrow), true, false);
 
 #ifdef AMREX_USE_OMP
 #pragma omp parallel if (Gpu::notInLaunchRegion())
@@ -54,19 +49,42 @@ MultiMask::define (const BoxArray& regba, const DistributionMapping& dm, const G
             AMREX_HOST_DEVICE_FOR_3D(fbx, i, j, k,
             {
                 if (domain.contains(IntVect(AMREX_D_DECL(i,j,k)))) {
-                    fab(i,j,k) = bndrydata_not_covered;
+                    fab(i,j,k) = bndrydata_covered;
                 } else {
                     fab(i,j,k) = bndrydata_outside_domain;
                 }
             });
         }
 
+        // The cells that are not covered are the coarse/fine boundary of
+        // regba, which is cached by FabArrayBase.  If regba is the BoxArray
+        // of a level's MultiFabs, the masks of all BndryData on that level
+        // share it.
         FabArray<Mask> regmf(regba, dm, 1, 0, MFInfo().SetAlloc(false));
-        const FabArrayBase::CPC& cpc = m_fa.getCPC(IntVect::TheZeroVector(),
-                                                   regmf,
-                                                   IntVect::TheZeroVector(),
-                                                   geom.periodicity());
-        m_fa.setVal(bndrydata_covered, cpc, 0, 1);
+        const bool include_periodic = true;
+        const bool include_physbndry = false;
+        const bool remove_periodic_images = true;
+        const FabArrayBase::CFinfo& cfinfo = FabArrayBase::TheCFinfo(regmf, geom, IntVect(ngrow),
+                                                                     include_periodic,
+                                                                     include_physbndry,
+                                                                     remove_periodic_images);
+        if (! cfinfo.ba_cfb.empty())
+        {
+            FabArray<Mask> cfmf(cfinfo.ba_cfb, cfinfo.dm_cfb, 1, 0, MFInfo().SetAlloc(false));
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+            for (MFIter mfi(cfmf); mfi.isValid(); ++mfi)
+            {
+                const int gid = cfinfo.fine_grid_idx[mfi.LocalIndex()];
+                auto const& fab = m_fa.array(gid);
+                Box const bx = mfi.validbox() & Box(fab);
+                AMREX_HOST_DEVICE_FOR_3D(bx, i, j, k,
+                {
+                    fab(i,j,k) = bndrydata_not_covered;
+                });
+            }
+        }
     }
 }
 
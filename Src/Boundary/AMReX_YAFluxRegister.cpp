@@ -2,10 +2,6 @@
 #include <AMReX_YAFluxRegister.H>
 #include <AMReX_YAFluxRegister_K.H>
 
-#ifdef AMREX_USE_OMP
-#include <omp.h>
-#endif
-
 namespace amrex {
 
 YAFluxRegister::YAFluxRegister (const BoxArray& fba, const BoxArray& cba,
@@ -38,13 +34,6 @@ YAFluxRegister::define (const BoxArray& fba, const BoxArray& cba,
     BoxArray cfba = fba;
     cfba.coarsen(ref_ratio);
 
-    Box cdomain = m_crse_geom.Domain();
-    for (int idim=0; idim < AMREX_SPACEDIM; ++idim) {
-        if (m_crse_geom.isPeriodic(idim)) {
-            cdomain.grow(idim,1);
-        }
-    }
-
     m_crse_fab_flag.resize(m_crse_flag.local_size(), crse_cell);
 
     m_crse_flag.setVal(crse_cell);
@@ -65,95 +54,45 @@ YAFluxRegister::define (const BoxArray& fba, const BoxArray& cba,
         }
     }
 
-    BoxList cfp_bl;
-    Vector<int> cfp_procmap;
+    //
+    // The crse/fine patches are the coarse cells just outside the coarsened
+    // fine grids.  Because the fine grids are coarsenable, they are the
+    // coarsened coarse/fine boundary of the fine grids ref_ratio cells wide,
+    // which FabArrayBase caches.  foo has the BoxArray and
+    // DistributionMapping of the fine level, so the cache entry is shared
+    // with the fine level's own MultiFabs and lives as long as they do.
+    //
+    BoxArray cfp_ba;
+    DistributionMapping cfp_dm;
     int nlocal = 0;
-    const int myproc = ParallelDescriptor::MyProc();
-    const int n_cfba = cfba.size();
-    cfba.uniqify();
-
-#ifdef AMREX_USE_OMP
-
-    const int nthreads = omp_get_max_threads();
-    Vector<BoxList> bl_priv(nthreads, BoxList());
-    Vector<Vector<int> > procmap_priv(nthreads);
-    Vector<Vector<int> > localindex_priv(nthreads);
-#pragma omp parallel
     {
-        BoxList bl_tmp;
-        const int tid = omp_get_thread_num();
-        BoxList& bl = bl_priv[tid];
-        Vector<int>& pmp = procmap_priv[tid];
-        Vector<int>& lid = localindex_priv[tid];
-#pragma omp for
-        for (int i = 0; i < n_cfba; ++i)
-        {
-            Box bx = amrex::grow(cfba[i], 1);
-            bx &= cdomain;
-
-            cfba.complementIn(bl_tmp, bx);
-            const int ntmp = bl_tmp.size();
-            bl.join(bl_tmp);
-
-            int proc = fdm[i];
-            for (int j = 0; j < ntmp; ++j) {
-                pmp.push_back(proc);
-            }
-
-            if (proc == myproc) {
-                lid.push_back(ntmp);
+        iMultiFab foo(fba, fdm, 1, 0, MFInfo().SetAlloc(false));
+        const bool include_periodic = true;
+        const bool include_physbndry = false;
+        const FabArrayBase::CFinfo& cfinfo = FabArrayBase::TheCFinfo(foo, m_fine_geom, ref_ratio,
+                                                                     include_periodic,
+                                                                     include_physbndry);
+        // It's safe even if there are no crse/fine patches.
+        cfp_ba = amrex::coarsen(cfinfo.ba_cfb, ref_ratio);
+        cfp_dm = cfinfo.dm_cfb;
+
+        const int myproc = ParallelDescriptor::MyProc();
+        Vector<int> fine_localindex(cfba.size(), -1);
+        for (int i = 0, N = cfba.size(); i < N; ++i) {
+            if (fdm[i] == myproc) {
+                fine_localindex[i] = nlocal++;
             }
         }
-    }
 
-    for (auto const& bl : bl_priv) {
-        cfp_bl.join(bl);
-    }
-
-    for (auto const& pmp : procmap_priv) {
-        cfp_procmap.insert(std::end(cfp_procmap), std::begin(pmp), std::end(pmp));
-    }
-
-    for (auto& lid : localindex_priv) {
-        for (int nl : lid) {
-            for (int j = 0; j < nl; ++j) {
-                m_cfp_localindex.push_back(nlocal);
-            }
-            ++nlocal;
+        // This Array store local index in fine ba/dm.  Its size is local size of cfp.
+        m_cfp_localindex.clear();
+        m_cfp_localindex.reserve(cfinfo.fine_grid_idx.size());
+        for (int i : cfinfo.fine_grid_idx) {
+            m_cfp_localindex.push_back(fine_localindex[i]);
         }
     }
 
-#else
-
-    BoxList bl_tmp;
-    for (int i = 0; i < n_cfba; ++i)
-    {
-        Box bx = amrex::grow(cfba[i], 1);
-        bx &= cdomain;
-
-        cfba.complementIn(bl_tmp, bx);
-        const int ntmp = bl_tmp.size();
-        cfp_bl.join(bl_tmp);
-
-        int proc = fdm[i];
-        for (int j = 0; j < ntmp; ++j) {
-            cfp_procmap.push_back(proc);
-        }
-
-        if (proc == myproc) {
-            for (int j = 0; j < ntmp; ++j) {
-                m_cfp_localindex.push_back(nlocal);  // This Array store local index in fine ba/dm.
-            }                                        // Its size is local size of cfp.
-            ++nlocal;
-        }
-    }
-
-#endif
-
-    // It's safe even if cfp_bl is empty.
-
-    BoxArray cfp_ba(std::move(cfp_bl));
-    DistributionMapping cfp_dm(std::move(cfp_procmap));
+    cfba.uniqify();
     m_cfpatch.define(cfp_ba, cfp_dm, nvar, 0, MFInfo(), FArrayBoxFactory());
 
     m_cfp_fab.resize(nlocal);
@@ -223,6 +162,7 @@ YAFluxRegister::define (const BoxArray& fba, const BoxArray& cba,
 void
 YAFluxRegister::reset ()
 {
+    SendToCrse_finish();
     m_crse_data.setVal(0.0);
     m_cfpatch.setVal(0.0);
 }
@@ -346,6 +286,45 @@ YAFluxRegister::FineAdd (const MFIter& mfi,
 
 void
 YAFluxRegister::Reflux (MultiFab& state, int dc)
+{
+    SendToCrse_finish();
+
+    maskCFPatch();
+
+    m_crse_data.ParallelCopy(m_cfpatch, m_crse_geom.periodicity(), FabArrayBase::ADD);
+
+    BL_ASSERT(state.nComp() >= dc + m_ncomp);
+    MultiFab::Add(state, m_crse_data, 0, dc, m_ncomp, 0);
+}
+
+void
+YAFluxRegister::SendToCrse_nowait ()
+{
+    BL_PROFILE("YAFluxRegister::SendToCrse_nowait()");
+
+    SendToCrse_finish();
+
+    maskCFPatch();
+
+    // The send buffers are packed and the local data are added before
+    // ParallelAdd_nowait returns, so m_cfpatch can be cleared.
+    m_crse_data.ParallelAdd_nowait(m_cfpatch, m_crse_geom.periodicity());
+    m_cfpatch.setVal(0.0);
+    m_sending = true;
+}
+
+void
+YAFluxRegister::SendToCrse_finish ()
+{
+    if (m_sending) {
+        BL_PROFILE("YAFluxRegister::SendToCrse_finish()");
+        m_crse_data.ParallelCopy_finish();
+        m_sending = false;
+    }
+}
+
+void
+YAFluxRegister::maskCFPatch ()
 {
     if (!m_cfp_mask.empty())
     {
@@ -364,11 +343,6 @@ YAFluxRegister::Reflux (MultiFab& state, int dc)
             });
         }
     }
-
-    m_crse_data.ParallelCopy(m_cfpatch, m_crse_geom.periodicity(), FabArrayBase::ADD);
-
-    BL_ASSERT(state.nComp() >= dc + m_ncomp);
-    MultiFab::Add(state, m_crse_data, 0, dc, m_ncomp, 0);
 }
 
 }
@@ -231,22 +231,9 @@ void
 EBFluxRegister::Reflux (MultiFab& crse_state, const amrex::MultiFab& crse_vfrac,
                         MultiFab& fine_state, const amrex::MultiFab& /*fine_vfrac*/)
 {
-    if (!m_cfp_mask.empty())
-    {
-#ifdef AMREX_USE_OMP
-#pragma omp parallel if (Gpu::notInLaunchRegion())
-#endif
-        for (MFIter mfi(m_cfpatch); mfi.isValid(); ++mfi)
-        {
-            Array4<Real> const& cfa = m_cfpatch.array(mfi);
-            Array4<Real const> const& m = m_cfp_mask.const_array(mfi);
-            const Box& bx = mfi.fabbox();
-            AMREX_HOST_DEVICE_PARALLEL_FOR_4D(bx,m_ncomp,i,j,k,n,
-            {
-                cfa(i,j,k,n) *= m(i,j,k);
-            });
-        }
-    }
+    SendToCrse_finish();
+
+    maskCFPatch();
 
     m_crse_data.ParallelCopy(m_cfpatch, m_crse_geom.periodicity(), FabArrayBase::ADD);
 
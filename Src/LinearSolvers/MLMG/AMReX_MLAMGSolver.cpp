@@ -0,0 +1,878 @@
+
+#include <AMReX_MLAMGSolver.H>
+#include <AMReX_MultiFabUtil.H>
+#include <AMReX_ParallelDescriptor.H>
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+
+namespace amrex {
+
+namespace {
+
+template <typename T>
+Vector<T> amg_allgatherv (Vector<T> const& local, MPI_Comm comm)
+{
+#ifdef BL_USE_MPI
+    int nprocs;
+    MPI_Comm_size(comm, &nprocs);
+    int n = static_cast<int>(local.size());
+    Vector<int> counts(nprocs);
+    MPI_Allgather(&n, 1, MPI_INT, counts.data(), 1, MPI_INT, comm);
+    Vector<int> displs(nprocs, 0);
+    for (int i = 1; i < nprocs; ++i) {
+        displs[i] = displs[i-1] + counts[i-1];
+    }
+    Vector<T> r(displs.back()+counts.back());
+    MPI_Allgatherv(local.data(), n, ParallelDescriptor::Mpi_typemap<T>::type(),
+                   r.data(), counts.data(), displs.data(),
+                   ParallelDescriptor::Mpi_typemap<T>::type(), comm);
+    return r;
+#else
+    amrex::ignore_unused(comm);
+    return local;
+#endif
+}
+
+// Build a CSR matrix from (row, col, val) triplets.  Duplicates are summed.
+MLAMGSolver::CSR
+amg_make_csr (int nrows, int ncols, Vector<int> const& trow, Vector<int> const& tcol,
+              Vector<Real> const& tval)
+{
+    MLAMGSolver::CSR m;
+    m.nrows = nrows;
+    m.ncols = ncols;
+    m.rowptr.assign(nrows+1, 0);
+    for (int r : trow) {
+        ++m.rowptr[r+1];
+    }
+    for (int i = 0; i < nrows; ++i) {
+        m.rowptr[i+1] += m.rowptr[i];
+    }
+    Vector<int> pos(m.rowptr.begin(), m.rowptr.end()-1);
+    Vector<int> col(trow.size());
+    Vector<Real> val(trow.size());
+    for (int n = 0, N = trow.size(); n < N; ++n) {
+        const int p = pos[trow[n]]++;
+        col[p] = tcol[n];
+        val[p] = tval[n];
+    }
+
+    // Sort each row by column and merge duplicates
+    Vector<std::pair<int,Real> > tmp;
+    int nnz = 0;
+    Vector<int> newptr(nrows+1, 0);
+    for (int i = 0; i < nrows; ++i) {
+        tmp.clear();
+        for (int jj = m.rowptr[i]; jj < m.rowptr[i+1]; ++jj) {
+            tmp.emplace_back(col[jj], val[jj]);
+        }
+        std::sort(tmp.begin(), tmp.end(),
+                  [] (std::pair<int,Real> const& a, std::pair<int,Real> const& b)
+                  { return a.first < b.first; });
+        for (int n = 0, N = tmp.size(); n < N; ++n) {
+            if (n > 0 && tmp[n].first == tmp[n-1].first) {
+                m.val.back() += tmp[n].second;
+            } else {
+                m.col.push_back(tmp[n].first);
+                m.val.push_back(tmp[n].second);
+                ++nnz;
+            }
+        }
+        newptr[i+1] = nnz;
+    }
+    m.rowptr = std::move(newptr);
+    return m;
+}
+
+// Remove the round-off noise of the probing, i.e., off-diagonal entries
+// that are tiny compared to the diagonal.
+void
+amg_drop_small (MLAMGSolver::CSR& a, Real rtol)
+{
+    int nnz = 0;
+    int start = 0;
+    for (int i = 0; i < a.nrows; ++i) {
+        Real d = 0.0;
+        for (int jj = start; jj < a.rowptr[i+1]; ++jj) {
+            if (a.col[jj] == i) d = std::abs(a.val[jj]);
+        }
+        for (int jj = start; jj < a.rowptr[i+1]; ++jj) {
+            if (a.col[jj] == i || std::abs(a.val[jj]) > rtol*d) {
+                a.col[nnz] = a.col[jj];
+                a.val[nnz] = a.val[jj];
+                ++nnz;
+            }
+        }
+        start = a.rowptr[i+1];
+        a.rowptr[i+1] = nnz;
+    }
+    a.col.resize(nnz);
+    a.val.resize(nnz);
+}
+
+MLAMGSolver::CSR
+amg_transpose (MLAMGSolver::CSR const& a)
+{
+    MLAMGSolver::CSR t;
+    t.nrows = a.ncols;
+    t.ncols = a.nrows;
+    t.rowptr.assign(t.nrows+1, 0);
+    for (int c : a.col) {
+        ++t.rowptr[c+1];
+    }
+    for (int i = 0; i < t.nrows; ++i) {
+        t.rowptr[i+1] += t.rowptr[i];
+    }
+    t.col.resize(a.col.size());
+    t.val.resize(a.val.size());
+    Vector<int> pos(t.rowptr.begin(), t.rowptr.end()-1);
+    for (int i = 0; i < a.nrows; ++i) {
+        for (int jj = a.rowptr[i]; jj < a.rowptr[i+1]; ++jj) {
+            const int p = pos[a.col[jj]]++;
+            t.col[p] = i;
+            t.val[p] = a.val[jj];
+        }
+    }
+    return t;
+}
+
+// c = a * b
+MLAMGSolver::CSR
+amg_spgemm (MLAMGSolver::CSR const& a, MLAMGSolver::CSR const& b)
+{
+    MLAMGSolver::CSR c;
+    c.nrows = a.nrows;
+    c.ncols = b.ncols;
+    c.rowptr.assign(c.nrows+1, 0);
+    Vector<int> marker(b.ncols, -1);
+    Vector<Real> acc(b.ncols, 0.0);
+    Vector<int> cols;
+    for (int i = 0; i < a.nrows; ++i) {
+        cols.clear();
+        for (int jj = a.rowptr[i]; jj < a.rowptr[i+1]; ++jj) {
+            const int j = a.col[jj];
+            const Real aij = a.val[jj];
+            for (int kk = b.rowptr[j]; kk < b.rowptr[j+1]; ++kk) {
+                const int k = b.col[kk];
+                if (marker[k] != i) {
+                    marker[k] = i;
+                    acc[k] = 0.0;
+                    cols.push_back(k);
+                }
+                acc[k] += aij * b.val[kk];
+            }
+        }
+        std::sort(cols.begin(), cols.end());
+        for (int k : cols) {
+            if (acc[k] != Real(0.0)) {
+                c.col.push_back(k);
+                c.val.push_back(acc[k]);
+            }
+        }
+        c.rowptr[i+1] = c.col.size();
+    }
+    return c;
+}
+
+// y = a * x
+void
+amg_spmv (MLAMGSolver::CSR const& a, Vector<Real> const& x, Vector<Real>& y)
+{
+    for (int i = 0; i < a.nrows; ++i) {
+        Real s = 0.0;
+        for (int jj = a.rowptr[i]; jj < a.rowptr[i+1]; ++jj) {
+            s += a.val[jj] * x[a.col[jj]];
+        }
+        y[i] = s;
+    }
+}
+
+Real
+amg_norminf (Vector<Real> const& v)
+{
+    Real r = 0.0;
+    for (Real x : v) {
+        r = std::max(r, std::abs(x));
+    }
+    return r;
+}
+
+// Greedy aggregation based on strong connections (Vanek, Mandel & Brezina).
+// Decoupled points (e.g., identity rows) are not aggregated and are left
+// to the smoother.  Points with only weak connections become aggregates
+// of their own, so that the near null space is still represented on the
+// coarse level.  Returns the number of aggregates.
+int
+amg_aggregate (MLAMGSolver::CSR const& a, Vector<int>& agg)
+{
+    constexpr Real theta = 0.02;
+
+    const int n = a.nrows;
+    Vector<Real> d(n, 0.0);
+    for (int i = 0; i < n; ++i) {
+        for (int jj = a.rowptr[i]; jj < a.rowptr[i+1]; ++jj) {
+            if (a.col[jj] == i) d[i] = std::abs(a.val[jj]);
+        }
+    }
+
+    Vector<int> sptr(n+1, 0);
+    Vector<int> scol;
+    for (int i = 0; i < n; ++i) {
+        for (int jj = a.rowptr[i]; jj < a.rowptr[i+1]; ++jj) {
+            const int j = a.col[jj];
+            if (j != i && std::abs(a.val[jj]) >= theta*std::sqrt(d[i]*d[j])
+                && a.val[jj] != Real(0.0)) {
+                scol.push_back(j);
+            }
+        }
+        sptr[i+1] = scol.size();
+    }
+
+    constexpr int unaggregated = -2;
+    constexpr int isolated = -1;
+    agg.assign(n, unaggregated);
+    for (int i = 0; i < n; ++i) {
+        if (a.rowptr[i+1] - a.rowptr[i] <= 1) agg[i] = isolated;
+    }
+
+    int nagg = 0;
+
+    // Phase 1: aggregates made of a root point and all its strong
+    // neighbors, none of which may already be aggregated.
+    for (int i = 0; i < n; ++i) {
+        if (agg[i] != unaggregated) continue;
+        bool free_nbrs = true;
+        for (int jj = sptr[i]; jj < sptr[i+1]; ++jj) {
+            if (agg[scol[jj]] != unaggregated) {
+                free_nbrs = false;
+                break;
+            }
+        }
+        if (free_nbrs) {
+            agg[i] = nagg;
+            for (int jj = sptr[i]; jj < sptr[i+1]; ++jj) {
+                agg[scol[jj]] = nagg;
+            }
+            ++nagg;
+        }
+    }
+
+    // Phase 2: attach the remaining points to a neighboring aggregate
+    Vector<int> agg1 = agg;
+    for (int i = 0; i < n; ++i) {
+        if (agg[i] != unaggregated) continue;
+        for (int jj = sptr[i]; jj < sptr[i+1]; ++jj) {
+            if (agg1[scol[jj]] >= 0) {
+                agg[i] = agg1[scol[jj]];
+                break;
+            }
+        }
+    }
+
+    // Phase 3: the leftovers form new aggregates with their free neighbors
+    for (int i = 0; i < n; ++i) {
+        if (agg[i] != unaggregated) continue;
+        agg[i] = nagg;
+        for (int jj = sptr[i]; jj < sptr[i+1]; ++jj) {
+            if (agg[scol[jj]] == unaggregated) agg[scol[jj]] = nagg;
+        }
+        ++nagg;
+    }
+
+    return nagg;
+}
+
+// Smoothed prolongator P = (I - omega D^{-1} A) P_tent, where P_tent is
+// the piecewise constant interpolation from the aggregates.
+MLAMGSolver::CSR
+amg_prolongator (MLAMGSolver::CSR const& a, Vector<Real> const& diag_inv,
+                 Vector<int> const& agg, int nagg)
+{
+    Real rho = 0.0; // Gershgorin bound of the spectral radius of D^{-1} A
+    for (int i = 0; i < a.nrows; ++i) {
+        Real s = 0.0;
+        for (int jj = a.rowptr[i]; jj < a.rowptr[i+1]; ++jj) {
+            s += std::abs(a.val[jj]);
+        }
+        rho = std::max(rho, s*std::abs(diag_inv[i]));
+    }
+    const Real omega = (rho > Real(0.0)) ? Real(4.0)/(Real(3.0)*rho) : Real(0.0);
+
+    MLAMGSolver::CSR p;
+    p.nrows = a.nrows;
+    p.ncols = nagg;
+    p.rowptr.assign(p.nrows+1, 0);
+    Vector<int> marker(nagg, -1);
+    Vector<Real> acc(nagg, 0.0);
+    Vector<int> cols;
+    for (int i = 0; i < a.nrows; ++i) {
+        cols.clear();
+        auto add = [&] (int c, Real v) {
+            if (marker[c] != i) {
+                marker[c] = i;
+                acc[c] = 0.0;
+                cols.push_back(c);
+            }
+            acc[c] += v;
+        };
+        if (agg[i] >= 0) add(agg[i], Real(1.0));
+        for (int jj = a.rowptr[i]; jj < a.rowptr[i+1]; ++jj) {
+            const int j = a.col[jj];
+            if (agg[j] >= 0) add(agg[j], -omega*diag_inv[i]*a.val[jj]);
+        }
+        std::sort(cols.begin(), cols.end());
+        for (int c : cols) {
+            if (acc[c] != Real(0.0)) {
+                p.col.push_back(c);
+                p.val.push_back(acc[c]);
+            }
+        }
+        p.rowptr[i+1] = p.col.size();
+    }
+    return p;
+}
+
+Vector<Real>
+amg_diag_inv (MLAMGSolver::CSR const& a)
+{
+    Vector<Real> dinv(a.nrows, 0.0);
+    for (int i = 0; i < a.nrows; ++i) {
+        for (int jj = a.rowptr[i]; jj < a.rowptr[i+1]; ++jj) {
+            if (a.col[jj] == i && a.val[jj] != Real(0.0)) {
+                dinv[i] = Real(1.0)/a.val[jj];
+            }
+        }
+    }
+    return dinv;
+}
+
+}
+
+MLAMGSolver::MLAMGSolver (MLLinOp& a_lp, int a_verbose)
+    : Lp(a_lp), verbose(a_verbose)
+{
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(Lp.getNComp() == 1,
+                                     "MLAMGSolver: only single component operators are supported");
+    assemble();
+    setup();
+}
+
+MLAMGSolver::~MLAMGSolver ()
+{}
+
+void
+MLAMGSolver::assemble ()
+{
+    BL_PROFILE("MLAMGSolver::assemble()");
+
+    const int amrlev = 0;
+    const int mglev = Lp.NMGLevels(amrlev) - 1;
+    const Geometry& geom = Lp.Geom(amrlev, mglev);
+    const BoxArray& ba = amrex::convert(Lp.m_grids[amrlev][mglev], Lp.m_ixtype);
+    const DistributionMapping& dm = Lp.m_dmap[amrlev][mglev];
+    const bool nodal = !Lp.isCellCentered();
+    MPI_Comm comm = Lp.BottomCommunicator();
+
+    // Cell-centered operators may use points two cells away for high
+    // order extrapolation at physical boundaries.
+    const int reach = nodal ? 1 : 2;
+    const int width = 2*reach + 1;
+
+    // The matrix is assembled on the host, so we use pinned memory for
+    // the temporary data.
+    MFInfo hinfo;
+    hinfo.SetArena(The_Pinned_Arena());
+
+    iMultiFab owner(ba, dm, 1, 0, hinfo);
+    iMultiFab dirichlet(ba, dm, 1, 0, hinfo);
+    if (Lp.bottomOwnerMask()) {
+        iMultiFab::Copy(owner, *Lp.bottomOwnerMask(), 0, 0, 1, 0);
+    } else {
+        owner.setVal(1);
+    }
+    if (Lp.bottomDirichletMask()) {
+        iMultiFab::Copy(dirichlet, *Lp.bottomDirichletMask(), 0, 0, 1, 0);
+    } else {
+        dirichlet.setVal(0);
+    }
+
+    // Number the unknowns.  m_gid holds id+1 for now so that the owner's
+    // value can be propagated with OverrideSync.
+    m_gid.define(ba, dm, 1, reach, hinfo);
+    m_gid.setVal(0);
+    Gpu::streamSynchronize();
+
+    int nlocal = 0;
+    for (MFIter mfi(m_gid); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.validbox();
+        Array4<int> const& gid = m_gid.array(mfi);
+        Array4<int const> const& own = owner.const_array(mfi);
+        Array4<int const> const& dir = dirichlet.const_array(mfi);
+        amrex::LoopOnCpu(bx, [&] (int i, int j, int k) noexcept
+        {
+            if (own(i,j,k) && !dir(i,j,k)) gid(i,j,k) = ++nlocal;
+        });
+    }
+
+    Vector<int> nlocal_all = amg_allgatherv(Vector<int>{nlocal}, comm);
+    Long nrows_tot = 0;
+    m_row_begin = 0;
+    const int myproc = ParallelContext::MyProcSub();
+    for (int i = 0, N = nlocal_all.size(); i < N; ++i) {
+        if (i < myproc) m_row_begin += nlocal_all[i];
+        nrows_tot += nlocal_all[i];
+    }
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(nrows_tot < static_cast<Long>(std::numeric_limits<int>::max()),
+                                     "MLAMGSolver: bottom level is too big");
+    m_nrows_local = nlocal;
+    const int nrows = static_cast<int>(nrows_tot);
+
+    m_gid.plus(m_row_begin, 0, 1, 0);
+    for (MFIter mfi(m_gid); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.validbox();
+        Array4<int> const& gid = m_gid.array(mfi);
+        Array4<int const> const& own = owner.const_array(mfi);
+        Array4<int const> const& dir = dirichlet.const_array(mfi);
+        amrex::LoopOnCpu(bx, [&] (int i, int j, int k) noexcept
+        {
+            if (!own(i,j,k) || dir(i,j,k)) gid(i,j,k) = 0;
+        });
+    }
+    if (nodal) {
+        amrex::OverrideSync(m_gid, owner, geom.periodicity());
+    }
+    m_gid.FillBoundary(geom.periodicity());
+    m_gid.plus(-1, 0, 1, reach);
+    Gpu::streamSynchronize();
+
+    // The matrix is probed with colored unit vectors.  Points with the same
+    // color are at least `width` apart, so that each entry of the
+    // operator appears in exactly one probe.  In periodic directions the
+    // period of the coloring must divide the number of points.
+    const Box& domain = geom.Domain();
+    int period[3] = {1,1,1};
+    int dlo[3] = {0,0,0};
+    int orange[3] = {0,0,0};
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        dlo[idim] = domain.smallEnd(idim);
+        orange[idim] = reach;
+        const int npts = domain.length(idim);
+        if (geom.isPeriodic(idim)) {
+            int p = std::min(width, npts);
+            while (npts % p != 0) ++p;
+            period[idim] = p;
+        } else {
+            period[idim] = width;
+        }
+    }
+    const int ncolors = period[0]*period[1]*period[2];
+
+    auto color_of = [&] (int i, int d) noexcept -> int
+    {
+        int m = (i - dlo[d]) % period[d];
+        return (m < 0) ? m + period[d] : m;
+    };
+
+    IntVect ng_in(1);
+    if (Lp.hasHiddenDimension()) ng_in[Lp.hiddenDirection()] = 0;
+    const auto& factory = *Lp.Factory(amrlev, mglev);
+    MultiFab in (ba, dm, 1, ng_in, hinfo, factory);
+    MultiFab out(ba, dm, 1, 0, hinfo, factory);
+
+    Vector<int> trow, tcol;
+    Vector<Real> tval;
+
+    for (int c = 0; c < ncolors; ++c)
+    {
+        const int cc[3] = {c % period[0], (c / period[0]) % period[1], c / (period[0]*period[1])};
+
+        in.setVal(0.0);
+        Gpu::streamSynchronize();
+        for (MFIter mfi(in); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.validbox();
+            Array4<Real> const& a = in.array(mfi);
+            amrex::LoopOnCpu(bx, [&] (int i, int j, int k) noexcept
+            {
+                if (color_of(i,0) == cc[0] && color_of(j,1) == cc[1] && color_of(k,2) == cc[2]) {
+                    a(i,j,k) = 1.0;
+                }
+            });
+        }
+
+        Lp.apply(amrlev, mglev, out, in, MLLinOp::BCMode::Homogeneous,
+                 MLLinOp::StateMode::Correction);
+        Gpu::streamSynchronize();
+
+        for (MFIter mfi(out); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.validbox();
+            Array4<Real const> const& a = out.const_array(mfi);
+            Array4<int const> const& gid = m_gid.const_array(mfi);
+            Array4<int const> const& own = owner.const_array(mfi);
+            Array4<int const> const& dir = dirichlet.const_array(mfi);
+            amrex::LoopOnCpu(bx, [&] (int i, int j, int k) noexcept
+            {
+                if (!own(i,j,k) || dir(i,j,k) || a(i,j,k) == Real(0.0)) return;
+                // Find the point in the stencil of (i,j,k) that has this color
+                const int ijk[3] = {i,j,k};
+                int off[3] = {0,0,0};
+                for (int d = 0; d < 3; ++d) {
+                    int o = -orange[d];
+                    while (o <= orange[d] && color_of(ijk[d]+o,d) != cc[d]) ++o;
+                    if (o > orange[d]) return;
+                    off[d] = o;
+                }
+                const int col = gid(i+off[0],j+off[1],k+off[2]);
+                if (col >= 0) {
+                    trow.push_back(gid(i,j,k));
+                    tcol.push_back(col);
+                    tval.push_back(a(i,j,k));
+                }
+            });
+        }
+    }
+
+    trow = amg_allgatherv(trow, comm);
+    tcol = amg_allgatherv(tcol, comm);
+    tval = amg_allgatherv(tval, comm);
+
+    // Points that are not connected to anything (e.g., covered EB cells)
+    // become identity rows.
+    Vector<int> has_diag(nrows, 0);
+    for (int n = 0, N = trow.size(); n < N; ++n) {
+        if (trow[n] == tcol[n]) has_diag[trow[n]] = 1;
+    }
+    for (int i = 0; i < nrows; ++i) {
+        if (!has_diag[i]) {
+            trow.push_back(i);
+            tcol.push_back(i);
+            tval.push_back(1.0);
+        }
+    }
+
+    m_A.clear();
+    m_A.push_back(amg_make_csr(nrows, nrows, trow, tcol, tval));
+    amg_drop_small(m_A[0], Real(1.e-12));
+
+    if (verbose >= 1) {
+        amrex::Print() << "MLAMGSolver: bottom matrix has " << nrows << " rows and "
+                       << m_A[0].col.size() << " nonzeros (" << ncolors << " probes)\n";
+    }
+}
+
+void
+MLAMGSolver::setup ()
+{
+    BL_PROFILE("MLAMGSolver::setup()");
+
+    constexpr int max_levels = 25;
+    constexpr int coarse_size = 256;
+    constexpr int max_direct_size = 2048;
+
+    m_P.clear();
+    m_R.clear();
+    m_diag_inv.clear();
+
+    while (true)
+    {
+        const CSR& a = m_A.back();
+        m_diag_inv.push_back(amg_diag_inv(a));
+
+        if (a.nrows <= coarse_size || static_cast<int>(m_A.size()) >= max_levels) break;
+
+        Vector<int> agg;
+        const int nagg = amg_aggregate(a, agg);
+        if (nagg == 0 || nagg > (a.nrows*9)/10) break;
+
+        CSR p = amg_prolongator(a, m_diag_inv.back(), agg, nagg);
+        CSR r = amg_transpose(p);
+        CSR ac = amg_spgemm(r, amg_spgemm(a, p));
+
+        m_P.push_back(std::move(p));
+        m_R.push_back(std::move(r));
+        m_A.push_back(std::move(ac));
+    }
+
+    const int nlevs = m_A.size();
+
+    // Factorize the coarsest operator with partial pivoting.  A (nearly)
+    // zero pivot is the null space of a singular operator.  The
+    // corresponding unknown is set to zero in the solve.
+    const CSR& ac = m_A.back();
+    const int n = ac.nrows;
+    m_direct_coarsest = (n <= max_direct_size);
+    if (m_direct_coarsest)
+    {
+        m_lu.assign(static_cast<std::size_t>(n)*n, 0.0);
+        Real amax = 0.0;
+        for (int i = 0; i < n; ++i) {
+            for (int jj = ac.rowptr[i]; jj < ac.rowptr[i+1]; ++jj) {
+                m_lu[static_cast<std::size_t>(i)*n+ac.col[jj]] = ac.val[jj];
+                amax = std::max(amax, std::abs(ac.val[jj]));
+            }
+        }
+        m_piv.resize(n);
+        m_zero_piv.assign(n, 0);
+        const Real tiny = Real(1.e-12)*amax;
+        for (int k = 0; k < n; ++k) {
+            int p = k;
+            for (int i = k+1; i < n; ++i) {
+                if (std::abs(m_lu[static_cast<std::size_t>(i)*n+k]) >
+                    std::abs(m_lu[static_cast<std::size_t>(p)*n+k])) {
+                    p = i;
+                }
+            }
+            m_piv[k] = p;
+            if (p != k) {
+                for (int j = 0; j < n; ++j) {
+                    std::swap(m_lu[static_cast<std::size_t>(k)*n+j],
+                              m_lu[static_cast<std::size_t>(p)*n+j]);
+                }
+            }
+            const Real pivot = m_lu[static_cast<std::size_t>(k)*n+k];
+            if (std::abs(pivot) <= tiny) {
+                m_zero_piv[k] = 1;
+                for (int i = k+1; i < n; ++i) {
+                    m_lu[static_cast<std::size_t>(i)*n+k] = 0.0;
+                }
+                continue;
+            }
+            for (int i = k+1; i < n; ++i) {
+                Real& lik = m_lu[static_cast<std::size_t>(i)*n+k];
+                if (lik == Real(0.0)) continue;
+                lik /= pivot;
+                for (int j = k+1; j < n; ++j) {
+                    m_lu[static_cast<std::size_t>(i)*n+j] -= lik*m_lu[static_cast<std::size_t>(k)*n+j];
+                }
+            }
+        }
+    }
+
+    m_res.resize(nlevs);
+    m_cor.resize(nlevs);
+    m_crhs.resize(nlevs);
+    for (int lev = 0; lev < nlevs; ++lev) {
+        m_res[lev].resize(m_A[lev].nrows);
+        m_cor[lev].resize(m_A[lev].nrows);
+        m_crhs[lev].resize(m_A[lev].nrows);
+    }
+
+    if (verbose >= 1) {
+        amrex::Print() << "MLAMGSolver: " << nlevs << " levels:";
+        for (auto const& a : m_A) {
+            amrex::Print() << " " << a.nrows;
+        }
+        amrex::Print() << (m_direct_coarsest ? ", direct" : ", smoother")
+                       << " coarsest solve\n";
+    }
+}
+
+void
+MLAMGSolver::smooth (int lev, Vector<Real>& x, Vector<Real> const& b, bool forward) const
+{
+    // Gauss-Seidel.  A forward sweep before and a backward sweep after
+    // the coarse grid correction make the V-cycle symmetric.
+    const CSR& a = m_A[lev];
+    const auto& dinv = m_diag_inv[lev];
+    const int n = a.nrows;
+    for (int ii = 0; ii < n; ++ii) {
+        const int i = forward ? ii : n-1-ii;
+        if (dinv[i] == Real(0.0)) continue;
+        Real s = b[i];
+        for (int jj = a.rowptr[i]; jj < a.rowptr[i+1]; ++jj) {
+            if (a.col[jj] != i) s -= a.val[jj]*x[a.col[jj]];
+        }
+        x[i] = s*dinv[i];
+    }
+}
+
+void
+MLAMGSolver::residual (int lev, Vector<Real>& r, Vector<Real> const& x,
+                       Vector<Real> const& b) const
+{
+    const CSR& a = m_A[lev];
+    for (int i = 0; i < a.nrows; ++i) {
+        Real s = b[i];
+        for (int jj = a.rowptr[i]; jj < a.rowptr[i+1]; ++jj) {
+            s -= a.val[jj]*x[a.col[jj]];
+        }
+        r[i] = s;
+    }
+}
+
+void
+MLAMGSolver::coarsestSolve (Vector<Real>& x, Vector<Real> const& b) const
+{
+    const int lev = m_A.size()-1;
+    if (!m_direct_coarsest) {
+        for (int i = 0; i < 8; ++i) {
+            smooth(lev, x, b, true);
+            smooth(lev, x, b, false);
+        }
+        return;
+    }
+
+    const int n = m_A[lev].nrows;
+    Vector<Real> y(b.begin(), b.begin()+n);
+    for (int k = 0; k < n; ++k) {
+        if (m_piv[k] != k) std::swap(y[k], y[m_piv[k]]);
+    }
+    for (int i = 0; i < n; ++i) {
+        Real s = y[i];
+        for (int k = 0; k < i; ++k) {
+            s -= m_lu[static_cast<std::size_t>(i)*n+k]*y[k];
+        }
+        y[i] = s;
+    }
+    for (int i = n-1; i >= 0; --i) {
+        if (m_zero_piv[i]) {
+            x[i] = 0.0;
+            continue;
+        }
+        Real s = y[i];
+        for (int j = i+1; j < n; ++j) {
+            s -= m_lu[static_cast<std::size_t>(i)*n+j]*x[j];
+        }
+        x[i] = s / m_lu[static_cast<std::size_t>(i)*n+i];
+    }
+}
+
+void
+MLAMGSolver::vcycle (int lev, Vector<Real>& x, Vector<Real> const& b)
+{
+    if (lev == static_cast<int>(m_A.size())-1) {
+        coarsestSolve(x, b);
+        return;
+    }
+
+    for (int i = 0; i < nu1; ++i) {
+        smooth(lev, x, b, true);
+    }
+
+    residual(lev, m_res[lev], x, b);
+    amg_spmv(m_R[lev], m_res[lev], m_crhs[lev+1]);
+
+    auto& xc = m_cor[lev+1];
+    std::fill(xc.begin(), xc.end(), Real(0.0));
+    vcycle(lev+1, xc, m_crhs[lev+1]);
+
+    const CSR& p = m_P[lev];
+    for (int i = 0; i < p.nrows; ++i) {
+        for (int jj = p.rowptr[i]; jj < p.rowptr[i+1]; ++jj) {
+            x[i] += p.val[jj]*xc[p.col[jj]];
+        }
+    }
+
+    for (int i = 0; i < nu2; ++i) {
+        smooth(lev, x, b, false);
+    }
+}
+
+int
+MLAMGSolver::solve (MultiFab& soln, const MultiFab& rhs, Real eps_rel, Real eps_abs,
+                    int max_iter)
+{
+    BL_PROFILE("MLAMGSolver::solve()");
+
+    MPI_Comm comm = Lp.BottomCommunicator();
+
+    MFInfo hinfo;
+    hinfo.SetArena(The_Pinned_Arena());
+    MultiFab hx(m_gid.boxArray(), m_gid.DistributionMap(), 1, 0, hinfo);
+    MultiFab hb(m_gid.boxArray(), m_gid.DistributionMap(), 1, 0, hinfo);
+    MultiFab::Copy(hx, soln, 0, 0, 1, 0);
+    MultiFab::Copy(hb, rhs, 0, 0, 1, 0);
+    Gpu::streamSynchronize();
+
+    Vector<Real> xloc(m_nrows_local, 0.0);
+    Vector<Real> bloc(m_nrows_local, 0.0);
+    const int row_begin = m_row_begin;
+    const int row_end = m_row_begin + m_nrows_local;
+    for (MFIter mfi(m_gid); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.validbox();
+        Array4<int const> const& gid = m_gid.const_array(mfi);
+        Array4<Real const> const& xa = hx.const_array(mfi);
+        Array4<Real const> const& ba = hb.const_array(mfi);
+        amrex::LoopOnCpu(bx, [&] (int i, int j, int k) noexcept
+        {
+            const int row = gid(i,j,k);
+            if (row >= row_begin && row < row_end) {
+                xloc[row-row_begin] = xa(i,j,k);
+                bloc[row-row_begin] = ba(i,j,k);
+            }
+        });
+    }
+
+    // Every process in the bottom communicator solves the whole system.
+    Vector<Real> x = amg_allgatherv(xloc, comm);
+    Vector<Real> b = amg_allgatherv(bloc, comm);
+    Vector<Real> r(x.size());
+    Vector<Real> e(x.size());
+
+    residual(0, r, x, b);
+    const Real rnorm0 = amg_norminf(r);
+    const Real eps = std::max(eps_rel*rnorm0, eps_abs);
+    Real rnorm = rnorm0;
+
+    int ret = 0;
+    iter = 0;
+    if (rnorm0 > eps)
+    {
+        ret = 2;
+        for (iter = 1; iter <= max_iter; ++iter)
+        {
+            std::fill(e.begin(), e.end(), Real(0.0));
+            vcycle(0, e, r);
+            for (int i = 0, N = x.size(); i < N; ++i) {
+                x[i] += e[i];
+            }
+            residual(0, r, x, b);
+            rnorm = amg_norminf(r);
+
+            if (verbose > 1) {
+                amrex::Print() << "MLAMGSolver: Iteration " << std::setw(4) << iter
+                               << " rel. err. " << rnorm/rnorm0 << "\n";
+            }
+
+            if (rnorm <= eps) {
+                ret = 0;
+                break;
+            }
+        }
+    }
+
+    if (verbose > 0) {
+        if (ret == 0) {
+            amrex::Print() << "MLAMGSolver: Final: Iteration " << std::setw(4) << iter
+                           << " rel. err. " << ((rnorm0 > Real(0.0)) ? rnorm/rnorm0 : Real(0.0))
+                           << "\n";
+        } else {
+            amrex::Print() << "MLAMGSolver: Failed to converge after " << max_iter
+                           << " iterations, rel. err. " << rnorm/rnorm0 << "\n";
+        }
+    }
+
+    for (MFIter mfi(m_gid); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.validbox();
+        Array4<int const> const& gid = m_gid.const_array(mfi);
+        Array4<Real> const& xa = hx.array(mfi);
+        amrex::LoopOnCpu(bx, [&] (int i, int j, int k) noexcept
+        {
+            const int row = gid(i,j,k);
+            xa(i,j,k) = (row >= 0) ? x[row] : Real(0.0);
+        });
+    }
+    MultiFab::Copy(soln, hx, 0, 0, 1, 0);
+
+    return ret;
+}
+
+}
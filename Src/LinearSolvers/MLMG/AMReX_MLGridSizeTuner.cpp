@@ -0,0 +1,86 @@
+
+#include <AMReX_MLGridSizeTuner.H>
+
+#include <functional>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <utility>
+
+namespace amrex {
+
+namespace {
+    std::map<std::string,std::pair<int,int> > s_tuned_grid_sizes;
+
+    std::size_t hash_boxes (BoxArray const& ba)
+    {
+        std::size_t seed = ba.size();
+        auto combine = [&seed] (int v) {
+            seed ^= std::hash<int>{}(v) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        };
+        for (Long i = 0, N = ba.size(); i < N; ++i) {
+            const Box b = ba[i];
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                combine(b.smallEnd(idim));
+                combine(b.bigEnd(idim));
+                combine(b.type(idim));
+            }
+        }
+        return seed;
+    }
+}
+
+bool
+MLGridSizeTuner::lookup (std::string const& key, LPInfo& info)
+{
+    auto it = s_tuned_grid_sizes.find(key);
+    if (it == s_tuned_grid_sizes.end()) {
+        return false;
+    } else {
+        info.agg_grid_size = it->second.first;
+        info.con_grid_size = it->second.second;
+        return true;
+    }
+}
+
+void
+MLGridSizeTuner::record (std::string const& key, LPInfo const& info)
+{
+    s_tuned_grid_sizes[key] = std::make_pair(info.agg_grid_size, info.con_grid_size);
+}
+
+std::string
+MLGridSizeTuner::makeKey (std::string const& name, Geometry const& geom, MultiFab const& sol,
+                          LPInfo const& info, BottomSolver bottom_solver)
+{
+    const BoxArray& grids = sol.boxArray();
+    std::ostringstream ss;
+    ss << std::setprecision(17)
+       << name
+       << " domain " << geom.Domain()
+       << " problo " << AMREX_D_TERM(geom.ProbLo(0), << " " << geom.ProbLo(1), << " " << geom.ProbLo(2))
+       << " probhi " << AMREX_D_TERM(geom.ProbHi(0), << " " << geom.ProbHi(1), << " " << geom.ProbHi(2))
+       << " coord " << geom.Coord()
+       << " periodic " << AMREX_D_TERM(geom.isPeriodic(0), << geom.isPeriodic(1), << geom.isPeriodic(2))
+       << " ncomp " << sol.nComp()
+       << " agg " << info.do_agglomeration
+       << " con " << info.do_consolidation
+       << " maxcoarsen " << info.max_coarsening_level
+       << " semicoarsen " << info.do_semicoarsening << " " << info.max_semicoarsening_level
+       << " bottom " << static_cast<int>(bottom_solver)
+       << " grids " << grids.size() << " " << std::hex << hash_boxes(grids) << std::dec
+       << " nprocs " << ParallelContext::NProcsSub();
+    return ss.str();
+}
+
+Vector<int>
+MLGridSizeTuner::candidates (int grid_size)
+{
+    Vector<int> r;
+    if (grid_size >= 4) r.push_back(grid_size/2);
+    r.push_back(grid_size);
+    r.push_back(grid_size*2);
+    return r;
+}
+
+}
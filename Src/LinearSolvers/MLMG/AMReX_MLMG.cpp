@@ -62,7 +62,8 @@ MLMG::solve (const Vector<MultiFab*>& a_sol, const Vector<MultiFab const*>& a_rh
         bottom_solver = linop.getDefaultBottomSolver();
     }
 
-    if (bottom_solver == BottomSolver::hypre || bottom_solver == BottomSolver::petsc) {
+    if (bottom_solver == BottomSolver::hypre || bottom_solver == BottomSolver::petsc ||
+        bottom_solver == BottomSolver::amg) {
         int mo = linop.getMaxOrder();
         if (a_sol[0]->hasEBFabFactory()) {
             linop.setMaxOrder(2);
@@ -87,40 +88,99 @@ MLMG::solve (const Vector<MultiFab*>& a_sol, const Vector<MultiFab const*>& a_rh
     int ncomp = linop.getNComp();
 
     bool local = true;
-    Real resnorm0 = MLResNormInf(finest_amr_lev, local);
-    Real rhsnorm0 = MLRhsNormInf(local);
+    Vector<Real> resnorm0 = MLResNormInfComps(finest_amr_lev, local);
+    Vector<Real> rhsnorm0 = MLRhsNormInfComps(local);
     if (!is_nsolve) {
-        ParallelAllReduce::Max<Real>({resnorm0, rhsnorm0}, ParallelContext::CommunicatorSub());
+        Vector<Real> tmp(resnorm0);
+        tmp.insert(tmp.end(), rhsnorm0.begin(), rhsnorm0.end());
+        ParallelAllReduce::Max(tmp.data(), 2*ncomp, ParallelContext::CommunicatorSub());
+        std::copy(tmp.begin(), tmp.begin()+ncomp, resnorm0.begin());
+        std::copy(tmp.begin()+ncomp, tmp.end(), rhsnorm0.begin());
+    }
 
-        if (verbose >= 1)
-        {
-            amrex::Print() << "MLMG: Initial rhs               = " << rhsnorm0 << "\n"
-                           << "MLMG: Initial residual (resid0) = " << resnorm0 << "\n";
-        }
+    m_init_resnorm0 = *std::max_element(resnorm0.begin(), resnorm0.end());
+    m_rhsnorm0 = *std::max_element(rhsnorm0.begin(), rhsnorm0.end());
+
+    if (!is_nsolve && verbose >= 1)
+    {
+        amrex::Print() << "MLMG: Initial rhs               = " << m_rhsnorm0 << "\n"
+                       << "MLMG: Initial residual (resid0) = " << m_init_resnorm0 << "\n";
     }
 
-    m_init_resnorm0 = resnorm0;
-    m_rhsnorm0 = rhsnorm0;
+    // Without per-component convergence, all components are measured
+    // against a single norm, i.e., the max over the components.
+    if (!per_comp_conv) {
+        resnorm0.assign(1, m_init_resnorm0);
+        rhsnorm0.assign(1, m_rhsnorm0);
+    }
+    const int nnorms = resnorm0.size();
 
-    Real max_norm;
+    Vector<Real> max_norm(nnorms);
+    Vector<Real> res_target(nnorms);
+    int nbnorm = 0;
+    for (int n = 0; n < nnorms; ++n) {
+        if (always_use_bnorm || rhsnorm0[n] >= resnorm0[n]) {
+            max_norm[n] = rhsnorm0[n];
+            ++nbnorm;
+        } else {
+            max_norm[n] = resnorm0[n];
+        }
+        res_target[n] = std::max(a_tol_abs, std::max(a_tol_rel,Real(1.e-16))*max_norm[n]);
+    }
     std::string norm_name;
-    if (always_use_bnorm || rhsnorm0 >= resnorm0) {
+    if (nbnorm == nnorms) {
         norm_name = "bnorm";
-        max_norm = rhsnorm0;
-    } else {
+    } else if (nbnorm == 0) {
         norm_name = "resid0";
-        max_norm = resnorm0;
+    } else {
+        norm_name = "max(bnorm,resid0)";
     }
-    const Real res_target = std::max(a_tol_abs, std::max(a_tol_rel,Real(1.e-16))*max_norm);
 
-    if (!is_nsolve && resnorm0 <= res_target) {
-        composite_norminf = resnorm0;
+    // Reduce per-component norms to the norms used for the convergence test
+    auto group_norms = [&] (Vector<Real> const& comp_norms) -> Vector<Real>
+    {
+        if (per_comp_conv) {
+            return comp_norms;
+        } else {
+            return {*std::max_element(comp_norms.begin(), comp_norms.end())};
+        }
+    };
+    auto is_converged = [&] (Vector<Real> const& norms) -> bool
+    {
+        for (int n = 0; n < nnorms; ++n) {
+            if (norms[n] > res_target[n]) return false;
+        }
+        return true;
+    };
+    // Same criterion as for a single norm, applied to each norm
+    auto is_diverged = [&] (Vector<Real> const& norms) -> bool
+    {
+        for (int n = 0; n < nnorms; ++n) {
+            if (norms[n] > Real(1.e20)*max_norm[n]) return true;
+        }
+        return false;
+    };
+    // Largest residual relative to its reference norm
+    auto rel_norm = [&] (Vector<Real> const& norms) -> Real
+    {
+        Real r = 0.0;
+        for (int n = 0; n < nnorms; ++n) {
+            if (max_norm[n] > Real(0.0)) {
+                r = std::max(r, norms[n]/max_norm[n]);
+            }
+        }
+        return r;
+    };
+
+    if (!is_nsolve && is_converged(resnorm0)) {
+        composite_norminf = m_init_resnorm0;
         if (verbose >= 1) {
             amrex::Print() << "MLMG: No iterations needed\n";
         }
     } else {
         auto iter_start_time = amrex::second();
         bool converged = false;
+        Vector<Real> composite_norms(nnorms, 0.0);
 
         const int niters = do_fixed_number_of_iters ? do_fixed_number_of_iters : max_iters;
         for (int iter = 0; iter < niters; ++iter)
@@ -134,28 +194,34 @@ MLMG::solve (const Vector<MultiFab*>& a_sol, const Vector<MultiFab const*>& a_rh
 
             if (is_nsolve) continue;
 
-            Real fine_norminf = ResNormInf(finest_amr_lev);
+            Vector<Real> fine_norms = group_norms(ResNormInfComps(finest_amr_lev));
+            Real fine_norminf = *std::max_element(fine_norms.begin(), fine_norms.end());
             m_iter_fine_resnorm0.push_back(fine_norminf);
             composite_norminf = fine_norminf;
+            composite_norms = fine_norms;
             if (verbose >= 2) {
                 amrex::Print() << "MLMG: Iteration " << std::setw(3) << iter+1 << " Fine resid/"
-                               << norm_name << " = " << fine_norminf/max_norm << "\n";
+                               << norm_name << " = " << rel_norm(fine_norms) << "\n";
             }
-            bool fine_converged = (fine_norminf <= res_target);
+            bool fine_converged = is_converged(fine_norms);
 
             if (namrlevs == 1 && fine_converged) {
                 converged = true;
             } else if (fine_converged) {
                 // finest level is converged, but we still need to test the coarse levels
                 computeMLResidual(finest_amr_lev-1);
-                Real crse_norminf = MLResNormInf(finest_amr_lev-1);
+                Vector<Real> crse_norms = group_norms(MLResNormInfComps(finest_amr_lev-1));
                 if (verbose >= 2) {
                     amrex::Print() << "MLMG: Iteration " << std::setw(3) << iter+1
                                    << " Crse resid/" << norm_name << " = "
-                                   << crse_norminf/max_norm << "\n";
+                                   << rel_norm(crse_norms) << "\n";
+                }
+                converged = is_converged(crse_norms);
+                for (int n = 0; n < nnorms; ++n) {
+                    composite_norms[n] = std::max(fine_norms[n], crse_norms[n]);
                 }
-                converged = (crse_norminf <= res_target);
-                composite_norminf = std::max(fine_norminf, crse_norminf);
+                composite_norminf = *std::max_element(composite_norms.begin(),
+                                                      composite_norms.end());
             } else {
                 converged = false;
             }
@@ -165,17 +231,17 @@ MLMG::solve (const Vector<MultiFab*>& a_sol, const Vector<MultiFab const*>& a_rh
                     amrex::Print() << "MLMG: Final Iter. " << iter+1
                                    << " resid, resid/" << norm_name << " = "
                                    << composite_norminf << ", "
-                                   << composite_norminf/max_norm << "\n";
+                                   << rel_norm(composite_norms) << "\n";
                 }
                 break;
             } else {
-              if (composite_norminf > Real(1.e20)*max_norm)
+              if (is_diverged(composite_norms))
               {
                   if (verbose > 0) {
                       amrex::Print() << "MLMG: Failing to converge after " << iter+1 << " iterations."
                                      << " resid, resid/" << norm_name << " = "
                                      << composite_norminf << ", "
-                                     << composite_norminf/max_norm << "\n";
+                                     << rel_norm(composite_norms) << "\n";
                   }
                   amrex::Abort("MLMG failing so lets stop here");
               }
@@ -187,7 +253,7 @@ MLMG::solve (const Vector<MultiFab*>& a_sol, const Vector<MultiFab const*>& a_rh
                 amrex::Print() << "MLMG: Failed to converge after " << max_iters << " iterations."
                                << " resid, resid/" << norm_name << " = "
                                << composite_norminf << ", "
-                               << composite_norminf/max_norm << "\n";
+                               << rel_norm(composite_norms) << "\n";
             }
             amrex::Abort("MLMG failed");
         }
@@ -406,10 +472,12 @@ MLMG::mgVcycle (int amrlev, int mglev_top)
     BL_PROFILE("MLMG::mgVcycle()");
 
     const int mglev_bottom = linop.NMGLevels(amrlev) - 1;
+    const bool timing = do_mglev_timing && amrlev == 0;
 
     for (int mglev = mglev_top; mglev < mglev_bottom; ++mglev)
     {
         BL_PROFILE_VAR("MLMG::mgVcycle_down::"+std::to_string(mglev), blp_mgv_down_lev);
+        const double t0 = timing ? mglevClock() : 0.0;
 
         if (verbose >= 4)
         {
@@ -425,6 +493,10 @@ MLMG::mgVcycle (int amrlev, int mglev_top)
                          skip_fillboundary);
             skip_fillboundary = false;
         }
+        if (timing) {
+            m_mglev_smooth_time[mglev] += mglevClock() - t0;
+            m_mglev_nsmooth[mglev] += nu1;
+        }
 
         // rescor = res - L(cor)
         computeResOfCorrection(amrlev, mglev);
@@ -439,9 +511,11 @@ MLMG::mgVcycle (int amrlev, int mglev_top)
         // res_crse = R(rescor_fine); this provides res/b to the level below
         linop.restriction(amrlev, mglev+1, res[amrlev][mglev+1], rescor[amrlev][mglev]);
 
+        if (timing) m_mglev_time[mglev] += mglevClock() - t0;
     }
 
     BL_PROFILE_VAR("MLMG::mgVcycle_bottom", blp_bottom);
+    const double tb = timing ? mglevClock() : 0.0;
     if (amrlev == 0)
     {
         if (verbose >= 4)
@@ -484,10 +558,12 @@ MLMG::mgVcycle (int amrlev, int mglev_top)
         }
     }
     BL_PROFILE_VAR_STOP(blp_bottom);
+    if (timing) m_mglev_time[mglev_bottom] += mglevClock() - tb;
 
     for (int mglev = mglev_bottom-1; mglev >= mglev_top; --mglev)
     {
         BL_PROFILE_VAR("MLMG::mgVcycle_up::"+std::to_string(mglev), blp_mgv_up_lev);
+        const double t0 = timing ? mglevClock() : 0.0;
         // cor_fine += I(cor_crse)
         addInterpCorrection(amrlev, mglev);
         if (verbose >= 4)
@@ -497,9 +573,14 @@ MLMG::mgVcycle (int amrlev, int mglev_top)
             amrex::Print() << "AT LEVEL "  << amrlev << " " << mglev
                            << "   UP: Norm before smooth " << norm << "\n";
         }
+        const double ts = timing ? mglevClock() : 0.0;
         for (int i = 0; i < nu2; ++i) {
             linop.smooth(amrlev, mglev, *cor[amrlev][mglev], res[amrlev][mglev]);
         }
+        if (timing) {
+            m_mglev_smooth_time[mglev] += mglevClock() - ts;
+            m_mglev_nsmooth[mglev] += nu2;
+        }
 
         if (cf_strategy == CFStrategy::ghostnodes) computeResOfCorrection(amrlev, mglev);
 
@@ -510,9 +591,18 @@ MLMG::mgVcycle (int amrlev, int mglev_top)
             amrex::Print() << "AT LEVEL "  << amrlev << " " << mglev
                            << "   UP: Norm after  smooth " << norm << "\n";
         }
+
+        if (timing) m_mglev_time[mglev] += mglevClock() - t0;
     }
 }
 
+double
+MLMG::mglevClock () const
+{
+    Gpu::streamSynchronize();
+    return amrex::second();
+}
+
 // FMG cycle on the coarsest AMR level.
 // in:  Residual on the top MG level (i.e., 0)
 // out: Correction (cor) on all MG levels
@@ -961,6 +1051,18 @@ MLMG::actualBottomSolve ()
         {
             bottomSolveWithPETSc(x, *bottom_b);
         }
+        else if (bottom_solver == BottomSolver::amg)
+        {
+            int ret = bottomSolveWithAMG(x, *bottom_b);
+            // If the AMG solve failed then set the correction to zero
+            if (ret != 0) {
+                cor[amrlev][mglev]->setVal(0.0);
+            }
+            const int n = (ret==0) ? nub : nuf;
+            for (int i = 0; i < n; ++i) {
+                linop.smooth(amrlev, mglev, x, b);
+            }
+        }
         else
         {
             MLCGSolver::Type cg_type;
@@ -1022,14 +1124,38 @@ MLMG::bottomSolveWithCG (MultiFab& x, const MultiFab& b, MLCGSolver::Type type)
     return ret;
 }
 
+int
+MLMG::bottomSolveWithAMG (MultiFab& x, const MultiFab& b)
+{
+    if (amg_solver == nullptr) {
+        amg_solver = std::make_unique<MLAMGSolver>(linop, bottom_verbose);
+    }
+    amg_solver->setVerbose(bottom_verbose);
+
+    int ret = amg_solver->solve(x, b, bottom_reltol, bottom_abstol, bottom_maxiter);
+    if (ret != 0 && verbose > 1) {
+        amrex::Print() << "MLMG: Bottom solve failed.\n";
+    }
+    m_niters_cg.push_back(amg_solver->getNumIters());
+    return ret;
+}
+
 // Compute single-level masked inf-norm of Residual (res).
 Real
 MLMG::ResNormInf (int alev, bool local)
+{
+    const auto& norms = ResNormInfComps(alev, local);
+    return *std::max_element(norms.begin(), norms.end());
+}
+
+// Computes the masked inf-norm of each component of Residual (res).
+Vector<Real>
+MLMG::ResNormInfComps (int alev, bool local)
 {
     BL_PROFILE("MLMG::ResNormInf()");
     const int ncomp = linop.getNComp();
     const int mglev = 0;
-    Real norm = 0.0;
+    Vector<Real> norms(ncomp, 0.0);
     MultiFab* pmf = &(res[alev][mglev]);
 #ifdef AMREX_USE_EB
     if (linop.isCellCentered() && scratch[alev]) {
@@ -1048,39 +1174,55 @@ MLMG::ResNormInf (int alev, bool local)
 #endif
     for (int n = 0; n < ncomp; n++)
     {
-        Real newnorm = 0.0;
         if (fine_mask[alev]) {
-            newnorm = pmf->norm0(*fine_mask[alev],n,0,true);
+            norms[n] = pmf->norm0(*fine_mask[alev],n,0,true);
         } else {
-            newnorm = pmf->norm0(n,0,true);
+            norms[n] = pmf->norm0(n,0,true);
         }
-        norm = std::max(norm, newnorm);
     }
-    if (!local) ParallelAllReduce::Max(norm, ParallelContext::CommunicatorSub());
-    return norm;
+    if (!local) ParallelAllReduce::Max(norms.data(), ncomp, ParallelContext::CommunicatorSub());
+    return norms;
 }
 
 // Computes multi-level masked inf-norm of Residual (res).
 Real
 MLMG::MLResNormInf (int alevmax, bool local)
+{
+    const auto& norms = MLResNormInfComps(alevmax, local);
+    return *std::max_element(norms.begin(), norms.end());
+}
+
+Vector<Real>
+MLMG::MLResNormInfComps (int alevmax, bool local)
 {
     BL_PROFILE("MLMG::MLResNormInf()");
-    Real r = 0.0;
+    const int ncomp = linop.getNComp();
+    Vector<Real> r(ncomp, 0.0);
     for (int alev = 0; alev <= alevmax; ++alev)
     {
-        r = std::max(r, ResNormInf(alev,true));
+        const auto& norms = ResNormInfComps(alev,true);
+        for (int n = 0; n < ncomp; ++n) {
+            r[n] = std::max(r[n], norms[n]);
+        }
     }
-    if (!local) ParallelAllReduce::Max(r, ParallelContext::CommunicatorSub());
+    if (!local) ParallelAllReduce::Max(r.data(), ncomp, ParallelContext::CommunicatorSub());
     return r;
 }
 
 // Compute multi-level masked inf-norm of RHS (rhs).
 Real
 MLMG::MLRhsNormInf (bool local)
+{
+    const auto& norms = MLRhsNormInfComps(local);
+    return *std::max_element(norms.begin(), norms.end());
+}
+
+Vector<Real>
+MLMG::MLRhsNormInfComps (bool local)
 {
     BL_PROFILE("MLMG::MLRhsNormInf()");
     const int ncomp = linop.getNComp();
-    Real r = 0.0;
+    Vector<Real> r(ncomp, 0.0);
     for (int alev = 0; alev <= finest_amr_lev; ++alev)
     {
         MultiFab* pmf = &(rhs[alev]);
@@ -1102,13 +1244,13 @@ MLMG::MLRhsNormInf (bool local)
         for (int n=0; n<ncomp; ++n)
         {
             if (alev < finest_amr_lev) {
-                r = std::max(r, pmf->norm0(*fine_mask[alev],n,0,true));
+                r[n] = std::max(r[n], pmf->norm0(*fine_mask[alev],n,0,true));
             } else {
-                r = std::max(r, pmf->norm0(n,0,true));
+                r[n] = std::max(r[n], pmf->norm0(n,0,true));
             }
         }
     }
-    if (!local) ParallelAllReduce::Max(r, ParallelContext::CommunicatorSub());
+    if (!local) ParallelAllReduce::Max(r.data(), ncomp, ParallelContext::CommunicatorSub());
     return r;
 }
 
@@ -1138,19 +1280,9 @@ MLMG::buildFineMask ()
 }
 
 void
-MLMG::prepareForSolve (const Vector<MultiFab*>& a_sol, const Vector<MultiFab const*>& a_rhs)
+MLMG::prepareLinOp ()
 {
-    BL_PROFILE("MLMG::prepareForSolve()");
-
-    AMREX_ASSERT(namrlevs <= a_sol.size());
-    AMREX_ASSERT(namrlevs <= a_rhs.size());
-
-    timer.assign(ntimers, 0.0);
-
-    const int ncomp = linop.getNComp();
-    IntVect ng_rhs(0);
-    IntVect ng_sol(1);
-    if (linop.hasHiddenDimension()) ng_sol[linop.hiddenDirection()] = 0;
+    BL_PROFILE("MLMG::prepareLinOp()");
 
     if (!linop_prepared) {
         linop.prepareForSolve();
@@ -1158,6 +1290,14 @@ MLMG::prepareForSolve (const Vector<MultiFab*>& a_sol, const Vector<MultiFab con
     } else if (linop.needsUpdate()) {
         linop.update();
 
+        // The N-Solve operator is made from a copy of linop's coefficients.
+        ns_linop.reset();
+        ns_mlmg.reset();
+        ns_sol.reset();
+        ns_rhs.reset();
+
+        amg_solver.reset();
+
 #if defined(AMREX_USE_HYPRE) && (AMREX_SPACEDIM > 1)
         hypre_solver.reset();
         hypre_bndry.reset();
@@ -1169,6 +1309,27 @@ MLMG::prepareForSolve (const Vector<MultiFab*>& a_sol, const Vector<MultiFab con
         petsc_bndry.reset();
 #endif
     }
+}
+
+void
+MLMG::prepareForSolve (const Vector<MultiFab*>& a_sol, const Vector<MultiFab const*>& a_rhs)
+{
+    BL_PROFILE("MLMG::prepareForSolve()");
+
+    AMREX_ASSERT(namrlevs <= a_sol.size());
+    AMREX_ASSERT(namrlevs <= a_rhs.size());
+
+    timer.assign(ntimers, 0.0);
+    m_mglev_time.assign(linop.NMGLevels(0), 0.0);
+    m_mglev_smooth_time.assign(linop.NMGLevels(0), 0.0);
+    m_mglev_nsmooth.assign(linop.NMGLevels(0), 0);
+
+    const int ncomp = linop.getNComp();
+    IntVect ng_rhs(0);
+    IntVect ng_sol(1);
+    if (linop.hasHiddenDimension()) ng_sol[linop.hiddenDirection()] = 0;
+
+    prepareLinOp();
 
     sol.resize(namrlevs);
     sol_raii.resize(namrlevs);
@@ -1511,12 +1672,7 @@ MLMG::compResidual (const Vector<MultiFab*>& a_res, const Vector<MultiFab*>& a_s
         }
     }
 
-    if (!linop_prepared) {
-        linop.prepareForSolve();
-        linop_prepared = true;
-    } else if (linop.needsUpdate()) {
-        linop.update();
-    }
+    prepareLinOp();
 
     const auto& amrrr = linop.AMRRefRatio();
 
@@ -1596,12 +1752,7 @@ MLMG::apply (const Vector<MultiFab*>& out, const Vector<MultiFab*>& a_in)
         rh[alev].setVal(0.0);
     }
 
-    if (!linop_prepared) {
-        linop.prepareForSolve();
-        linop_prepared = true;
-    } else if (linop.needsUpdate()) {
-        linop.update();
-    }
+    prepareLinOp();
 
     for (int alev = 0; alev < namrlevs; ++alev) {
         linop.applyInhomogNeumannTerm(alev, rh[alev]);
@@ -39,16 +39,20 @@ MLNodeLaplacian::buildStencil ()
         for (int mglev = 0; mglev < m_num_mg_levels[amrlev]; ++mglev)
         {
             const int nghost = (0 == amrlev && mglev+1 == m_num_mg_levels[amrlev]) ? 1 : 4;
-            m_stencil[amrlev][mglev] = std::make_unique<MultiFab>
-                (amrex::convert(m_grids[amrlev][mglev], IntVect::TheNodeVector()),
-                 m_dmap[amrlev][mglev], ncomp_s, nghost);
+            if (m_stencil[amrlev][mglev] == nullptr) {
+                m_stencil[amrlev][mglev] = std::make_unique<MultiFab>
+                    (amrex::convert(m_grids[amrlev][mglev], IntVect::TheNodeVector()),
+                     m_dmap[amrlev][mglev], ncomp_s, nghost);
+            }
             m_stencil[amrlev][mglev]->setVal(0.0);
         }
 
         if (amrlev > 0) {
-            m_nosigma_stencil[amrlev] = std::make_unique<MultiFab>
-                (amrex::convert(m_grids[amrlev][0], IntVect::TheNodeVector()),
-                 m_dmap[amrlev][0], ncomp_s, 4);
+            if (m_nosigma_stencil[amrlev] == nullptr) {
+                m_nosigma_stencil[amrlev] = std::make_unique<MultiFab>
+                    (amrex::convert(m_grids[amrlev][0], IntVect::TheNodeVector()),
+                     m_dmap[amrlev][0], ncomp_s, 4);
+            }
             m_nosigma_stencil[amrlev]->setVal(0.0);
         }
 
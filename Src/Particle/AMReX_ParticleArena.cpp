@@ -0,0 +1,33 @@
+#include <AMReX_ParticleArena.H>
+
+#include <AMReX.H>
+
+namespace amrex {
+
+namespace {
+    CArena* the_particle_arena = nullptr;
+
+    void ParticleArena_Finalize ()
+    {
+        delete the_particle_arena;
+        the_particle_arena = nullptr;
+    }
+}
+
+void
+ParticleArena_Initialize ()
+{
+    if (the_particle_arena == nullptr) {
+        the_particle_arena = new CArena(0, The_Arena()->arenaInfo());
+        amrex::ExecOnFinalize(ParticleArena_Finalize);
+    }
+}
+
+CArena*
+The_Particle_Arena ()
+{
+    AMREX_ASSERT(the_particle_arena != nullptr);
+    return the_particle_arena;
+}
+
+}
@@ -262,6 +262,73 @@ int ParticleContainerBase::AggregationBuffer ()
     return aggregation_buffer;
 }
 
+bool ParticleContainerBase::SortedDeposition ()
+{
+    static bool sorted_deposition;
+    static bool first = true;
+
+    if (first)
+    {
+        first = false;
+        sorted_deposition = false;
+        ParmParse pp("particles");
+        pp.queryAdd("sorted_deposition", sorted_deposition);
+    }
+
+    return sorted_deposition;
+}
+
+bool ParticleContainerBase::IncrementalRedistribute ()
+{
+    static bool incremental_redistribute;
+    static bool first = true;
+
+    if (first)
+    {
+        first = false;
+        incremental_redistribute = false;
+        ParmParse pp("particles");
+        pp.queryAdd("incremental_redistribute", incremental_redistribute);
+    }
+
+    return incremental_redistribute;
+}
+
+bool ParticleContainerBase::SFCSort ()
+{
+    static bool sfc_sort;
+    static bool first = true;
+
+    if (first)
+    {
+        first = false;
+        sfc_sort = false;
+        ParmParse pp("particles");
+        pp.queryAdd("sfc_sort", sfc_sort);
+    }
+
+    return sfc_sort;
+}
+
+Real ParticleContainerBase::TileShrinkFactor ()
+{
+    static Real tile_shrink_factor;
+    static bool first = true;
+
+    if (first)
+    {
+        first = false;
+        tile_shrink_factor = 0.0;
+        ParmParse pp("particles");
+        pp.queryAdd("tile_shrink_factor", tile_shrink_factor);
+        if (tile_shrink_factor != 0.0 && tile_shrink_factor < 1.0) {
+            amrex::Abort("particles.tile_shrink_factor must be 0 or at least 1");
+        }
+    }
+
+    return tile_shrink_factor;
+}
+
 void ParticleContainerBase::BuildRedistributeMask (int lev, int nghost) const
 {
     BL_PROFILE("ParticleContainer::BuildRedistributeMask");
@@ -1,4 +1,10 @@
 #include <AMReX_ParticleUtil.H>
+#include <AMReX_BoxIterator.H>
+#include <AMReX_Morton.H>
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
 
 namespace amrex
 {
@@ -19,6 +25,32 @@ IntVect computeRefFac (const ParGDBBase* a_gdb, int src_lev, int lev)
     return ref_fac;
 }
 
+Vector<int> computeMortonCellOrder (const IntVect& len)
+{
+    const Box bx(IntVect(0), len - 1);
+    const int ncells = static_cast<int>(bx.numPts());
+
+    // Interleave the low and the high bits separately and concatenate.
+    constexpr int nbits = (AMREX_SPACEDIM == 3) ? 10 : ((AMREX_SPACEDIM == 2) ? 16 : 32);
+    Vector<std::pair<std::uint64_t,int> > keys;
+    keys.reserve(ncells);
+    for (BoxIterator bit(bx); bit.ok(); ++bit) {
+        const IntVect iv = bit();
+        std::uint64_t klo = 0, khi = 0;
+        for (int idim = AMREX_SPACEDIM-1; idim >= 0; --idim) {
+            const auto i = static_cast<std::uint64_t>(iv[idim]);
+            klo = (klo << 1) | Morton::makeSpace(static_cast<std::uint32_t>(i % (std::uint64_t(1) << nbits)));
+            khi = (khi << 1) | Morton::makeSpace(static_cast<std::uint32_t>(i >> nbits));
+        }
+        keys.emplace_back((khi << (nbits*AMREX_SPACEDIM)) | klo, static_cast<int>(bx.index(iv)));
+    }
+    std::sort(keys.begin(), keys.end());
+
+    Vector<int> order(ncells);
+    for (int n = 0; n < ncells; ++n) { order[keys[n].second] = n; }
+    return order;
+}
+
 Vector<int> computeNeighborProcs (const ParGDBBase* a_gdb, int ngrow)
 {
     BL_PROFILE("amrex::computeNeighborProcs");
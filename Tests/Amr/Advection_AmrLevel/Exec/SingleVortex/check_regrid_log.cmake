@@ -0,0 +1,66 @@
+#
+# Check the regrid log written with inputs-ci.regrid_log.
+#
+#   cmake -DLOG=<file> -DNSTEPS=<max_step> -P check_regrid_log.cmake
+#
+# Every line must be a JSON object for a "step" or a "regrid" event with
+# the cells, boxes and load balance of each level.  There must be one
+# step line per coarse step and at least one regrid line.  With CMake
+# 3.19 or newer, every line is also parsed as JSON.
+#
+if (NOT EXISTS "${LOG}")
+   message(FATAL_ERROR "regrid log ${LOG} not found")
+endif ()
+
+file(STRINGS "${LOG}" _lines)
+
+set(_nsteps 0)
+set(_nregrids 0)
+foreach (_line IN LISTS _lines)
+   if (NOT _line MATCHES "^{\"event\":\"(step|regrid)\",.*}$")
+      message(FATAL_ERROR "regrid log: not a step or regrid event: ${_line}")
+   endif ()
+   set(_event ${CMAKE_MATCH_1})
+   foreach (_field "\"step\":" "\"time\":" "\"finest_level\":" "\"levels\":[{\"level\":0,"
+                   "\"cells\":" "\"boxes\":" "\"dm_efficiency\":" "\"dm_cost\":")
+      string(FIND "${_line}" "${_field}" _pos)
+      if (_pos LESS 0)
+         message(FATAL_ERROR "regrid log: no ${_field} in ${_line}")
+      endif ()
+   endforeach ()
+
+   if (_event STREQUAL "step")
+      math(EXPR _nsteps "${_nsteps}+1")
+      set(_fields "\"step_time\":")
+   else ()
+      math(EXPR _nregrids "${_nregrids}+1")
+      set(_fields "\"phase_times\":{\"grid_places\":" "\"total\":" "\"bytes_moved\":")
+   endif ()
+   foreach (_field IN LISTS _fields)
+      string(FIND "${_line}" "${_field}" _pos)
+      if (_pos LESS 0)
+         message(FATAL_ERROR "regrid log: no ${_field} in ${_line}")
+      endif ()
+   endforeach ()
+
+   if (NOT CMAKE_VERSION VERSION_LESS 3.19)
+      string(JSON _nlevs ERROR_VARIABLE _err LENGTH "${_line}" levels)
+      if (_err)
+         message(FATAL_ERROR "regrid log: ${_err}: ${_line}")
+      endif ()
+      string(JSON _finest GET "${_line}" finest_level)
+      math(EXPR _expected "${_finest}+1")
+      if (NOT _nlevs EQUAL _expected)
+         message(FATAL_ERROR "regrid log: ${_nlevs} levels for finest_level ${_finest}: ${_line}")
+      endif ()
+   endif ()
+endforeach ()
+
+if (NOT _nsteps EQUAL NSTEPS)
+   message(FATAL_ERROR "regrid log: ${_nsteps} step lines, expected ${NSTEPS}")
+endif ()
+if (_nregrids LESS 1)
+   message(FATAL_ERROR "regrid log: no regrid line")
+endif ()
+
+message(STATUS "regrid log: ${_nsteps} step and ${_nregrids} regrid lines")
@@ -13,6 +13,7 @@ using namespace amrex;
 int      AmrLevelAdv::verbose         = 0;
 Real     AmrLevelAdv::cfl             = 0.9;
 int      AmrLevelAdv::do_reflux       = 1;
+int      AmrLevelAdv::async_reflux    = 0;
 
 int      AmrLevelAdv::NUM_STATE       = 1;  // One variable in the state
 int      AmrLevelAdv::NUM_GROW        = 3;  // number of ghost cells
@@ -206,7 +207,11 @@ AmrLevelAdv::init (AmrLevel &old)
 
     MultiFab& S_new = get_new_data(Phi_Type);
 
-    FillPatch(old, S_new, 0, cur_time, Phi_Type, 0, NUM_STATE);
+    if (parent->incrementalRegrid()) {
+        FillPatchIncremental(old, S_new, cur_time, Phi_Type);
+    } else {
+        FillPatch(old, S_new, 0, cur_time, Phi_Type, 0, NUM_STATE);
+    }
 }
 
 /**
@@ -385,6 +390,11 @@ AmrLevelAdv::advance (Real time,
         if (current) {
             for (int i = 0; i < BL_SPACEDIM ; i++)
                 current->FineAdd(fluxes[i],i,0,0,NUM_STATE,1.);
+            if (async_reflux) {
+                // Overlap sending the fluxes with the rest of the fine steps
+                current->SendToCrse_nowait(getLevel(level-1).get_new_data(Phi_Type),
+                                           parent->Geom(level-1));
+            }
         }
         if (fine) {
             for (int i = 0; i < BL_SPACEDIM ; i++)
@@ -743,6 +753,7 @@ AmrLevelAdv::read_params ()
     pp.query("v",verbose);
     pp.query("cfl",cfl);
     pp.query("do_reflux",do_reflux);
+    pp.query("async_reflux",async_reflux);
 
     Geometry const* gg = AMReX::top()->getDefaultGeometry();
 
@@ -0,0 +1,322 @@
+/*
+ * Performance benchmark for the cell-centered conservative linear
+ * coarse-to-fine interpolation on the CPU.
+ *
+ * For every combination of refinement ratio, domain size, box size,
+ * number of components and number of threads, the benchmark times
+ *
+ *   - the fine-cell kernel: the generic per-cell kernel
+ *     (mf_cell_cons_lin_interp) versus the CPU kernel that is specialized
+ *     for ratios 2 and 4 (mf_cell_cons_lin_interp_cpu),
+ *   - MFCellConsLinInterp::interp, i.e., the slopes and the fine cells,
+ *   - the FArrayBox based CellConservativeLinear::interp.
+ *
+ * The fastest of nreps repetitions is reported.  The two fine-cell
+ * kernels must give the same result; the largest difference is reported
+ * too.  The results are written as a JSON document by the I/O process.
+ */
+
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_Geometry.H>
+#include <AMReX_Interpolater.H>
+#include <AMReX_MFInterpolater.H>
+#include <AMReX_MFInterp_C.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_ParallelReduce.H>
+#include <AMReX_OpenMP.H>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <string>
+
+using namespace amrex;
+
+namespace {
+
+struct Params
+{
+    Vector<int> ratio{2};
+    Vector<int> n_cell{128};
+    Vector<int> max_grid_size{32};
+    Vector<int> ncomp{1};
+    Vector<int> nthreads{0};       // 0: do not change the number of threads
+    int nghost = 2;
+    int nreps = 5;
+    std::string output = "interp_benchmark.json";
+};
+
+struct Result
+{
+    int ratio = 0;
+    int n_cell = 0;
+    int max_grid_size = 0;
+    int ncomp = 0;
+    int nthreads = 0;
+    int nboxes = 0;
+    Long nfine = 0;
+    double generic_time = std::numeric_limits<double>::max();
+    double specialized_time = std::numeric_limits<double>::max();
+    double mfinterp_time = std::numeric_limits<double>::max();
+    double fabinterp_time = std::numeric_limits<double>::max();
+    Real max_diff = 0.;
+};
+
+void init_crse (MultiFab& crse, Geometry const& cgeom)
+{
+    const auto problo = cgeom.ProbLoArray();
+    const auto dx = cgeom.CellSizeArray();
+    const int ncomp = crse.nComp();
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(crse,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.tilebox();
+        Array4<Real> const& a = crse.array(mfi);
+        amrex::ParallelFor(bx, ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+        {
+            amrex::ignore_unused(j,k);
+            // A smooth field with a few discontinuities, so that the
+            // limiters are active somewhere.
+            Real r = Real(1.0) + n;
+            AMREX_D_TERM(const Real x = problo[0] + (i+Real(0.5))*dx[0];
+                         r += std::sin(Real(6.0)*x);,
+                         const Real y = problo[1] + (j+Real(0.5))*dx[1];
+                         r += std::cos(Real(4.0)*y);,
+                         const Real z = problo[2] + (k+Real(0.5))*dx[2];
+                         r += std::sin(Real(2.0)*z););
+            if (((i/7) + (n%2)) % 3 == 0) r += Real(0.5);
+            a(i,j,k,n) = r;
+        });
+    }
+}
+
+template <typename F>
+double time_it (int nreps, F&& f)
+{
+    double tmin = std::numeric_limits<double>::max();
+    for (int irep = 0; irep < nreps; ++irep) {
+        ParallelDescriptor::Barrier();
+        const double t0 = amrex::second();
+        f();
+        double t = amrex::second() - t0;
+        ParallelAllReduce::Max(t, ParallelDescriptor::Communicator());
+        tmin = std::min(tmin, t);
+    }
+    return tmin;
+}
+
+Result run_case (Params const& p, int ratio, int n_cell, int max_grid_size, int ncomp)
+{
+    BL_PROFILE("InterpBenchmark::run_case()");
+
+    Result r;
+    r.ratio = ratio;
+    r.n_cell = n_cell;
+    r.max_grid_size = max_grid_size;
+    r.ncomp = ncomp;
+    r.nthreads = OpenMP::get_max_threads();
+
+    const IntVect rr(ratio);
+    const IntVect ng(p.nghost);
+
+    RealBox rb({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+    Array<int,AMREX_SPACEDIM> is_periodic{AMREX_D_DECL(0,0,0)};
+    Box fdomain(IntVect(0), IntVect(n_cell-1));
+    Geometry fgeom(fdomain, rb, 0, is_periodic);
+    Geometry cgeom(amrex::coarsen(fdomain,rr), rb, 0, is_periodic);
+
+    BoxArray fba(fdomain);
+    fba.maxSize(max_grid_size);
+    DistributionMapping dm(fba);
+    r.nboxes = fba.size();
+
+    // Each coarse box covers its fine box including the ghost cells, as in
+    // FillPatch.
+    BoxList cbl;
+    for (int i = 0, N = fba.size(); i < N; ++i) {
+        cbl.push_back(mf_cell_cons_interp.CoarseBox(amrex::grow(fba[i],ng), rr));
+    }
+    BoxArray cba(std::move(cbl));
+
+    MultiFab crse(cba, dm, ncomp, 0);
+    init_crse(crse, cgeom);
+
+    MultiFab fine_a(fba, dm, ncomp, ng);
+    MultiFab fine_b(fba, dm, ncomp, ng);
+    fine_a.setVal(0.0);
+    fine_b.setVal(0.0);
+    r.nfine = fine_a.boxArray().numPts();
+
+    const Box& dest_domain = amrex::grow(fdomain, ng);
+
+    Vector<BCRec> bcs(ncomp, BCRec(AMREX_D_DECL(BCType::foextrap,BCType::foextrap,BCType::foextrap),
+                                   AMREX_D_DECL(BCType::foextrap,BCType::foextrap,BCType::foextrap)));
+
+    // Slopes for the fine-cell kernels
+    BoxArray sba = cba;
+    sba.grow(-1);
+    MultiFab slope(sba, dm, AMREX_SPACEDIM*ncomp, 0);
+    {
+        Box const& cdomain = cgeom.Domain();
+        BCRec const* pbc = bcs.data();
+#ifdef AMREX_USE_OMP
+#pragma omp parallel
+#endif
+        for (MFIter mfi(slope, true); mfi.isValid(); ++mfi) {
+            auto const& s = slope.array(mfi);
+            auto const& c = crse.const_array(mfi);
+            amrex::LoopConcurrentOnCpu(mfi.tilebox(), ncomp, [&] (int i, int j, int k, int n) noexcept
+            {
+                mf_cell_cons_lin_interp_mcslope(i,j,k,n, s, c, 0, ncomp, cdomain, rr, pbc);
+            });
+        }
+    }
+
+    r.generic_time = time_it(p.nreps, [&] ()
+    {
+#ifdef AMREX_USE_OMP
+#pragma omp parallel
+#endif
+        for (MFIter mfi(fine_a, true); mfi.isValid(); ++mfi) {
+            Box const& fbox = mfi.growntilebox(ng) & dest_domain;
+            auto const& f = fine_a.array(mfi);
+            auto const& s = slope.const_array(mfi);
+            auto const& c = crse.const_array(mfi);
+            amrex::LoopConcurrentOnCpu(fbox, ncomp, [&] (int i, int j, int k, int n) noexcept
+            {
+                mf_cell_cons_lin_interp(i,j,k,n, f, 0, s, c, 0, ncomp, rr);
+            });
+        }
+    });
+
+    r.specialized_time = time_it(p.nreps, [&] ()
+    {
+#ifdef AMREX_USE_OMP
+#pragma omp parallel
+#endif
+        for (MFIter mfi(fine_b, true); mfi.isValid(); ++mfi) {
+            Box const& fbox = mfi.growntilebox(ng) & dest_domain;
+            mf_cell_cons_lin_interp_cpu(fbox, ncomp, fine_b.array(mfi), 0, slope.const_array(mfi),
+                                        crse.const_array(mfi), 0, rr);
+        }
+    });
+
+    MultiFab::Subtract(fine_b, fine_a, 0, 0, ncomp, ng);
+    r.max_diff = fine_b.norminf(0, ncomp, ng);
+
+    r.mfinterp_time = time_it(p.nreps, [&] ()
+    {
+        mf_cell_cons_interp.interp(crse, 0, fine_a, 0, ncomp, ng, cgeom, fgeom,
+                                   dest_domain, rr, bcs, 0);
+    });
+
+    r.fabinterp_time = time_it(p.nreps, [&] ()
+    {
+#ifdef AMREX_USE_OMP
+#pragma omp parallel
+#endif
+        for (MFIter mfi(fine_a); mfi.isValid(); ++mfi) {
+            Box const& fbox = mfi.fabbox() & dest_domain;
+            cell_cons_interp.interp(crse[mfi], 0, fine_a[mfi], 0, ncomp, fbox, rr,
+                                    cgeom, fgeom, bcs, 0, 0, RunOn::Cpu);
+        }
+    });
+
+    return r;
+}
+
+void write_json (std::ostream& os, Vector<Result> const& results)
+{
+    os << std::setprecision(6);
+    os << "{\n"
+       << "  \"benchmark\": \"Interp\",\n"
+       << "  \"amrex_version\": \"" << amrex::Version() << "\",\n"
+       << "  \"spacedim\": " << AMREX_SPACEDIM << ",\n"
+       << "  \"nranks\": " << ParallelDescriptor::NProcs() << ",\n"
+       << "  \"cases\": [";
+    for (int n = 0, N = results.size(); n < N; ++n)
+    {
+        Result const& r = results[n];
+        const double ncells = double(r.nfine) * double(r.ncomp);
+        os << (n == 0 ? "\n" : ",\n")
+           << "    {\n"
+           << "      \"ratio\": " << r.ratio << ",\n"
+           << "      \"n_cell\": " << r.n_cell << ",\n"
+           << "      \"max_grid_size\": " << r.max_grid_size << ",\n"
+           << "      \"ncomp\": " << r.ncomp << ",\n"
+           << "      \"nboxes\": " << r.nboxes << ",\n"
+           << "      \"nthreads\": " << r.nthreads << ",\n"
+           << "      \"generic_kernel_time\": " << r.generic_time << ",\n"
+           << "      \"specialized_kernel_time\": " << r.specialized_time << ",\n"
+           << "      \"kernel_speedup\": " << ((r.specialized_time > 0.) ? r.generic_time/r.specialized_time : 0.) << ",\n"
+           << "      \"kernel_max_diff\": " << r.max_diff << ",\n"
+           << "      \"mfinterp_time\": " << r.mfinterp_time << ",\n"
+           << "      \"mfinterp_ns_per_cell\": " << r.mfinterp_time/ncells*1.e9 << ",\n"
+           << "      \"fabinterp_time\": " << r.fabinterp_time << ",\n"
+           << "      \"fabinterp_ns_per_cell\": " << r.fabinterp_time/ncells*1.e9 << "\n"
+           << "    }";
+    }
+    os << "\n  ]\n}\n";
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        BL_PROFILE("main()");
+
+        Params p;
+        {
+            ParmParse pp;
+            pp.queryarr("ratio", p.ratio);
+            pp.queryarr("n_cell", p.n_cell);
+            pp.queryarr("max_grid_size", p.max_grid_size);
+            pp.queryarr("ncomp", p.ncomp);
+            pp.queryarr("nthreads", p.nthreads);
+            pp.query("nghost", p.nghost);
+            pp.query("nreps", p.nreps);
+            pp.query("output", p.output);
+        }
+
+        Vector<Result> results;
+        for (int ratio : p.ratio) {
+        for (int n_cell : p.n_cell) {
+        for (int max_grid_size : p.max_grid_size) {
+        for (int ncomp : p.ncomp) {
+        for (int nthreads : p.nthreads) {
+#ifdef AMREX_USE_OMP
+            if (nthreads > 0) omp_set_num_threads(nthreads);
+#else
+            amrex::ignore_unused(nthreads);
+#endif
+            results.push_back(run_case(p, ratio, n_cell, max_grid_size, ncomp));
+            Result const& r = results.back();
+            amrex::Print() << "InterpBenchmark: ratio = " << ratio << " n_cell = " << n_cell
+                           << " max_grid_size = " << max_grid_size << " ncomp = " << ncomp
+                           << " nthreads = " << r.nthreads
+                           << ": kernel " << r.generic_time << " -> " << r.specialized_time
+                           << " s, MFInterp " << r.mfinterp_time
+                           << " s, FabInterp " << r.fabinterp_time
+                           << " s, max diff " << r.max_diff << "\n";
+            if (r.max_diff != Real(0.)) {
+                amrex::Abort("InterpBenchmark: the specialized kernel does not match the generic one");
+            }
+        }}}}}
+
+        if (ParallelDescriptor::IOProcessor()) {
+            std::ofstream ofs(p.output);
+            if (!ofs.good()) {
+                amrex::FileOpenFailed(p.output);
+            }
+            write_json(ofs, results);
+        }
+    }
+    amrex::Finalize();
+}
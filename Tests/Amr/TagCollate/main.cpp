@@ -0,0 +1,197 @@
+/*
+ * Test of the compressed tag lists of TagBoxArray::collate.
+ *
+ * The encoding is checked on its own, for an empty list, isolated cells,
+ * long runs, dense blocks and several lists in one buffer: decoding must
+ * give back the tags in the same order.  The size of the encoding is
+ * compared with the size of the raw IntVect list.  Then the result of
+ * TagBoxArray::collate is compared with a plain gather of the tags of
+ * every process.  Run the test with several MPI ranks so that the tags
+ * come from many fabs on many ranks.
+ */
+
+#include <AMReX.H>
+#include <AMReX_TagBox.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_Print.H>
+
+#include <string>
+
+using namespace amrex;
+
+namespace {
+
+// The tags of bx for which f(iv) is true, in the order of the cells of bx
+template <typename F>
+Vector<IntVect> make_tags (Box const& bx, F&& f)
+{
+    Vector<IntVect> tags;
+    for (IntVect iv = bx.smallEnd(); iv <= bx.bigEnd(); bx.next(iv)) {
+        if (f(iv)) { tags.push_back(iv); }
+    }
+    return tags;
+}
+
+Long raw_size (Long ntags)
+{
+    return ntags*AMREX_SPACEDIM;
+}
+
+// Encode the lists one after another into one buffer, decode it, and
+// check that the result is the concatenation of the lists.  Return the
+// size of the encoding in ints.
+Long check_round_trip (std::string const& name, Vector<Vector<IntVect>> const& lists)
+{
+    Vector<int> buf;
+    Vector<IntVect> expected;
+    for (auto const& tags : lists) {
+        detail::encode_tags(tags.data(), tags.size(), buf);
+        expected.insert(expected.end(), tags.begin(), tags.end());
+    }
+
+    Gpu::PinnedVector<IntVect> decoded;
+    detail::decode_tags(buf, decoded);
+
+    AMREX_ALWAYS_ASSERT(decoded.size() == expected.size());
+    for (int i = 0, N = expected.size(); i < N; ++i) {
+        AMREX_ALWAYS_ASSERT(decoded[i] == expected[i]);
+    }
+
+    amrex::Print() << "TagCollate: " << name << ": " << expected.size() << " tags, "
+                   << buf.size() << " ints encoded, " << raw_size(expected.size())
+                   << " ints raw\n";
+    return buf.size();
+}
+
+void test_encoding ()
+{
+    const Box bx(IntVect(-5), IntVect(26));
+
+    // Nothing is written for an empty list.
+    AMREX_ALWAYS_ASSERT(check_round_trip("empty", {Vector<IntVect>{}}) == 0);
+
+    check_round_trip("single cell", {Vector<IntVect>{IntVect(3)}});
+
+    // Isolated cells, i.e., runs of length one
+    auto sparse = make_tags(bx, [] (IntVect const& iv) { return iv.sum() % 7 == 0; });
+    check_round_trip("isolated cells", {sparse});
+
+    // A checkerboard: every other cell, for which the bit mask is shorter
+    auto checker = make_tags(bx, [] (IntVect const& iv) { return (iv.sum() & 1) == 0; });
+    Long n = check_round_trip("checkerboard", {checker});
+    AMREX_ALWAYS_ASSERT(n < raw_size(checker.size()));
+
+    // Long runs in the first direction
+    auto slabs = make_tags(bx, [] (IntVect const& iv) {
+        for (int idim = 1; idim < AMREX_SPACEDIM; ++idim) {
+            if (iv[idim] % 4 != 0) return false;
+        }
+        return iv[0] > 0;
+    });
+    n = check_round_trip("runs", {slabs});
+    AMREX_ALWAYS_ASSERT(n < raw_size(slabs.size()));
+
+    // A dense block, whose bit mask size is not a multiple of 32 bits
+    auto dense = make_tags(Box(IntVect(0), IntVect(12)), [] (IntVect const&) { return true; });
+    n = check_round_trip("dense block", {dense});
+    AMREX_ALWAYS_ASSERT(n*2 < raw_size(dense.size()));
+
+    // Several lists in one buffer, as for the fabs of one process,
+    // including empty ones and lists of both encodings.
+    check_round_trip("chunks", {Vector<IntVect>{}, dense, sparse, Vector<IntVect>{IntVect(-5)},
+                                Vector<IntVect>{}, checker, slabs, Vector<IntVect>{IntVect(26)}});
+}
+
+// Compare TagBoxArray::collate with a gather of the uncompressed tags
+void test_collate ()
+{
+    const Box domain(IntVect(0), IntVect(47));
+    BoxArray ba(domain);
+    ba.maxSize(8);
+    DistributionMapping dm(ba);
+
+    TagBoxArray tags(ba, dm, 0);
+    tags.setVal(TagBox::CLEAR);
+    const IntVect center(24);
+    for (MFIter mfi(tags); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.validbox();
+        auto const& arr = tags.array(mfi);
+        amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            IntVect iv(AMREX_D_DECL(i,j,k));
+            IntVect d = iv - center;
+            int r2 = AMREX_D_TERM(d[0]*d[0], + d[1]*d[1], + d[2]*d[2]);
+            bool shell = (r2 >= 100 && r2 < 144);    // runs of many lengths
+            bool block = (iv >= IntVect(30) && iv <= IntVect(40));  // dense, across fabs
+            bool isolated = (iv.sum() % 29 == 0);
+            if (shell || block || isolated) {
+                arr(i,j,k) = TagBox::SET;
+            }
+        });
+    }
+
+    Gpu::PinnedVector<IntVect> collated;
+    tags.collate(collated);
+
+    // The uncompressed path: gather the IntVects of every process.
+    Gpu::PinnedVector<IntVect> local;
+    tags.local_collate(local);
+    const int IOProc = ParallelDescriptor::IOProcessorNumber();
+    const int count = local.size()*AMREX_SPACEDIM;
+    const std::vector<int>& countvec = ParallelDescriptor::Gather(count, IOProc);
+    std::vector<int> offset(countvec.size(), 0);
+    Vector<int> recvbuf;
+    if (ParallelDescriptor::IOProcessor()) {
+        for (int i = 1, N = offset.size(); i < N; ++i) {
+            offset[i] = offset[i-1] + countvec[i-1];
+        }
+        recvbuf.resize(offset.back() + countvec.back());
+    }
+    const int* psend = local.empty() ? nullptr : local.data()->begin();
+    ParallelDescriptor::Gatherv(psend, count, recvbuf.data(), countvec, offset, IOProc);
+
+    // The size of the encoding, one list per fab as in collate
+    Long encoded_size = 0;
+    {
+        Vector<int> buf;
+        const IntVect* p = local.data();
+        const IntVect* pend = p + local.size();
+        for (MFIter mfi(tags); mfi.isValid() && p < pend; ++mfi) {
+            const IntVect* q = p;
+            while (q < pend && mfi.fabbox().contains(*q)) { ++q; }
+            detail::encode_tags(p, q-p, buf);
+            p = q;
+        }
+        encoded_size = buf.size();
+    }
+    ParallelDescriptor::ReduceLongSum(encoded_size, IOProc);
+
+    if (ParallelDescriptor::IOProcessor()) {
+        const Long ntags = recvbuf.size() / AMREX_SPACEDIM;
+        AMREX_ALWAYS_ASSERT(ntags > 0);
+        AMREX_ALWAYS_ASSERT(static_cast<Long>(collated.size()) == ntags);
+        for (Long i = 0; i < ntags; ++i) {
+            AMREX_ALWAYS_ASSERT(collated[i] == IntVect(recvbuf.data() + i*AMREX_SPACEDIM));
+        }
+        AMREX_ALWAYS_ASSERT(encoded_size < raw_size(ntags));
+        amrex::Print() << "TagCollate: collate: " << ntags << " tags in " << ba.size()
+                       << " fabs on " << ParallelDescriptor::NProcs() << " ranks, "
+                       << encoded_size << " ints encoded, " << raw_size(ntags)
+                       << " ints raw\n";
+    }
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+
+    test_encoding();
+    test_collate();
+
+    amrex::Print() << "TagCollate: passed\n";
+
+    amrex::Finalize();
+}
@@ -80,6 +80,7 @@ MyTest::solve ()
     mlmg.setBottomVerbose(bottom_verbose);
     if (use_hypre) mlmg.setBottomSolver(MLMG::BottomSolver::hypre);
     if (use_petsc) mlmg.setBottomSolver(MLMG::BottomSolver::petsc);
+    if (use_amg) mlmg.setBottomSolver(MLMG::BottomSolver::amg);
     const Real tol_rel = reltol;
     const Real tol_abs = 0.0;
     mlmg.solve(amrex::GetVecOfPtrs(phi), amrex::GetVecOfConstPtrs(rhs), tol_rel, tol_abs);
@@ -140,6 +141,7 @@ MyTest::readParameters ()
 #ifdef AMREX_USE_PETSC
     pp.query("use_petsc",use_petsc);
 #endif
+    pp.query("use_amg", use_amg);
 }
 
 void
@@ -0,0 +1,439 @@
+/*
+ * Performance benchmark for MLMG.
+ *
+ * For every combination of operator, domain size, box size, number of
+ * threads and LPInfo agglomeration/consolidation grid sizes, a Dirichlet
+ * problem is solved several times and the fastest solve is reported.
+ * The results are written as a JSON document by the I/O process.  Run the
+ * benchmark with different numbers of MPI ranks to sweep over ranks.
+ *
+ * Reported for each case are the solve, V-cycle and bottom solve times,
+ * the time per MG level of a V-cycle, an estimate of the smoother's
+ * memory bandwidth, and the time of FillBoundary versus the compute part
+ * of an operator application on the finest level.  All times are the
+ * maximum over the MPI ranks.  With tune_grid_sizes = 1, the agglomeration
+ * and consolidation grid sizes are chosen by MLGridSizeTuner instead.
+ */
+
+#include <AMReX.H>
+#include <AMReX_MLMG.H>
+#include <AMReX_MLGridSizeTuner.H>
+#include <AMReX_MLPoisson.H>
+#include <AMReX_MLABecLaplacian.H>
+#include <AMReX_MLNodeLaplacian.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_ParallelReduce.H>
+#include <AMReX_OpenMP.H>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <string>
+
+using namespace amrex;
+
+namespace {
+
+struct Params
+{
+    Vector<std::string> operators{"poisson"};
+    Vector<int> n_cell{64};
+    Vector<int> max_grid_size{32};
+    Vector<int> nthreads{0};       // 0: do not change the number of threads
+    Vector<int> agg_grid_size{-1};
+    Vector<int> con_grid_size{-1};
+    std::string bottom_solver = "bicgstab";
+    int nsolves = 3;
+    int nreps = 20;                // # of FillBoundary and apply calls to time
+    int max_iter = 100;
+    Real reltol = 1.e-10;
+    int verbose = 0;
+    bool tune_grid_sizes = false;  // tune agg/con grid sizes with MLGridSizeTuner
+    int tune_max_iters = 0;        // iteration limit of the tuning candidates, 0: default
+    std::string output = "mlmg_benchmark.json";
+};
+
+struct Result
+{
+    std::string op;
+    int n_cell = 0;
+    int max_grid_size = 0;
+    int nthreads = 0;
+    int agg_grid_size = 0;
+    int con_grid_size = 0;
+    int nboxes = 0;
+    int niters = 0;
+    Real final_resid = 0.;         // final residual / initial residual
+    double tuning_time = 0.;
+    Vector<MLGridSizeTuner::Trial> tuning_trials;
+    double setup_time = 0.;
+    double solve_time = std::numeric_limits<double>::max();
+    double iter_time = 0.;
+    double bottom_time = 0.;
+    double fb_time = 0.;
+    double apply_time = 0.;
+    Vector<Long> level_ncells;
+    Vector<int> level_nboxes;
+    Vector<double> level_time;
+    Vector<double> level_smooth_time;
+    Vector<int> level_nsmooth;
+};
+
+// Bytes read and written per point in one smoothing sweep.  This is a
+// lower bound that counts the solution, the right-hand side and the
+// coefficients once.
+int smoother_bytes_per_point (std::string const& op)
+{
+    int nreals = 3;                              // sol (read & write), rhs
+    if (op == "abeclap") nreals += 1 + AMREX_SPACEDIM; // acoef, bcoef
+    if (op == "nodal") nreals += 1;              // sigma
+    return nreals * static_cast<int>(sizeof(Real));
+}
+
+MLMG::BottomSolver bottom_solver_type (std::string const& s)
+{
+    if (s == "bicgstab") return MLMG::BottomSolver::bicgstab;
+    if (s == "cg") return MLMG::BottomSolver::cg;
+    if (s == "smoother") return MLMG::BottomSolver::smoother;
+    if (s == "amg") return MLMG::BottomSolver::amg;
+    if (s == "hypre") return MLMG::BottomSolver::hypre;
+    amrex::Abort("MLMGBenchmark: unknown bottom_solver "+s);
+    return MLMG::BottomSolver::Default;
+}
+
+void init_rhs (MultiFab& rhs, Geometry const& geom)
+{
+    const auto problo = geom.ProbLoArray();
+    const auto dx = geom.CellSizeArray();
+    const IntVect ixt = rhs.ixType().toIntVect();
+    const Real pi = 3.14159265358979323846;
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(rhs,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.tilebox();
+        Array4<Real> const& a = rhs.array(mfi);
+        amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            amrex::ignore_unused(j,k);
+            Real r = 1.0;
+            AMREX_D_TERM(r *= std::sin(pi*(problo[0]+(i+0.5*(1-ixt[0]))*dx[0]));,
+                         r *= std::sin(pi*(problo[1]+(j+0.5*(1-ixt[1]))*dx[1]));,
+                         r *= std::sin(pi*(problo[2]+(k+0.5*(1-ixt[2]))*dx[2])));
+            a(i,j,k) = r;
+        });
+    }
+}
+
+Result run_case (Params const& p, std::string const& op, int n_cell, int max_grid_size,
+                 int agg_grid_size, int con_grid_size)
+{
+    BL_PROFILE("MLMGBenchmark::run_case()");
+
+    Result r;
+    r.op = op;
+    r.n_cell = n_cell;
+    r.max_grid_size = max_grid_size;
+    r.nthreads = OpenMP::get_max_threads();
+    r.agg_grid_size = agg_grid_size;
+    r.con_grid_size = con_grid_size;
+
+    RealBox rb({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+    Array<int,AMREX_SPACEDIM> is_periodic{AMREX_D_DECL(0,0,0)};
+    Box domain(IntVect(0), IntVect(n_cell-1));
+    Geometry geom(domain, rb, 0, is_periodic);
+
+    BoxArray grids(domain);
+    grids.maxSize(max_grid_size);
+    DistributionMapping dmap(grids);
+    r.nboxes = grids.size();
+
+    const bool nodal = (op == "nodal");
+    const BoxArray& ba = nodal ? amrex::convert(grids, IntVect(1)) : grids;
+
+    MultiFab sol(ba, dmap, 1, 1);
+    MultiFab rhs(ba, dmap, 1, 0);
+    init_rhs(rhs, geom);
+
+    LPInfo info;
+    if (agg_grid_size > 0) info.setAgglomerationGridSize(agg_grid_size);
+    if (con_grid_size > 0) info.setConsolidationGridSize(con_grid_size);
+
+    const Array<LinOpBCType,AMREX_SPACEDIM> bc{AMREX_D_DECL(LinOpBCType::Dirichlet,
+                                                            LinOpBCType::Dirichlet,
+                                                            LinOpBCType::Dirichlet)};
+
+    MultiFab acoef, sigma;
+    Array<MultiFab,AMREX_SPACEDIM> bcoef;
+    if (op == "abeclap") {
+        acoef.define(grids, dmap, 1, 0);
+        acoef.setVal(1.0);
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            bcoef[idim].define(amrex::convert(grids, IntVect::TheDimensionVector(idim)), dmap, 1, 0);
+            bcoef[idim].setVal(1.0+idim);
+        }
+    } else if (op == "nodal") {
+        sigma.define(grids, dmap, 1, 0);
+        sigma.setVal(1.0);
+    }
+    sol.setVal(0.0);
+
+    auto make_linop = [&] (LPInfo const& a_info) -> std::unique_ptr<MLLinOp>
+    {
+        if (op == "poisson")
+        {
+            auto lp = std::make_unique<MLPoisson>(Vector<Geometry>{geom}, Vector<BoxArray>{grids},
+                                                  Vector<DistributionMapping>{dmap}, a_info);
+            lp->setDomainBC(bc, bc);
+            lp->setLevelBC(0, &sol);
+            return lp;
+        }
+        else if (op == "abeclap")
+        {
+            auto lp = std::make_unique<MLABecLaplacian>(Vector<Geometry>{geom}, Vector<BoxArray>{grids},
+                                                        Vector<DistributionMapping>{dmap}, a_info);
+            lp->setDomainBC(bc, bc);
+            lp->setLevelBC(0, &sol);
+            lp->setScalars(1.0, 1.0);
+            lp->setACoeffs(0, acoef);
+            lp->setBCoeffs(0, amrex::GetArrOfConstPtrs(bcoef));
+            return lp;
+        }
+        else if (op == "nodal")
+        {
+            auto lp = std::make_unique<MLNodeLaplacian>(Vector<Geometry>{geom}, Vector<BoxArray>{grids},
+                                                        Vector<DistributionMapping>{dmap}, a_info);
+            lp->setDomainBC(bc, bc);
+            lp->setSigma(0, sigma);
+            return lp;
+        }
+        amrex::Abort("MLMGBenchmark: unknown operator "+op);
+        return nullptr;
+    };
+
+    double t0 = amrex::second();
+    if (p.tune_grid_sizes) {
+        info = MLGridSizeTuner::tune(op, info, make_linop, geom, sol, rhs, p.reltol, 0.0, p.verbose,
+                                     bottom_solver_type(p.bottom_solver), p.tune_max_iters,
+                                     &r.tuning_trials);
+        // The choice must be a trial that converged, unless it came from the registry.
+        AMREX_ALWAYS_ASSERT(r.tuning_trials.empty() ||
+            std::any_of(r.tuning_trials.begin(), r.tuning_trials.end(),
+                        [&] (MLGridSizeTuner::Trial const& t) {
+                            return !t.rejected && t.agg_grid_size == info.agg_grid_size
+                                && t.con_grid_size == info.con_grid_size; }));
+        r.agg_grid_size = info.agg_grid_size;
+        r.con_grid_size = info.con_grid_size;
+        r.tuning_time = amrex::second() - t0;
+        t0 = amrex::second();
+    }
+
+    auto linop = make_linop(info);
+
+    MLMG mlmg(*linop);
+    mlmg.setMaxIter(p.max_iter);
+    mlmg.setVerbose(p.verbose);
+    mlmg.setBottomSolver(bottom_solver_type(p.bottom_solver));
+    mlmg.setMGLevelTiming(true);
+
+    // The first solve includes the setup of the operator.
+    sol.setVal(0.0);
+    mlmg.solve({&sol}, {&rhs}, p.reltol, 0.0);
+    r.setup_time = amrex::second() - t0;
+
+    for (int isolve = 0; isolve < p.nsolves; ++isolve)
+    {
+        sol.setVal(0.0);
+        mlmg.solve({&sol}, {&rhs}, p.reltol, 0.0);
+
+        Vector<double> t{mlmg.getSolveTime(), mlmg.getIterTime(), mlmg.getBottomTime()};
+        const int nlevs = mlmg.getNumMGLevels();
+        t.insert(t.end(), mlmg.getMGLevelTimes().begin(), mlmg.getMGLevelTimes().end());
+        t.insert(t.end(), mlmg.getMGLevelSmoothTimes().begin(), mlmg.getMGLevelSmoothTimes().end());
+        ParallelReduce::Max<double>(t.data(), t.size(), ParallelDescriptor::IOProcessorNumber(),
+                                    ParallelDescriptor::Communicator());
+
+        if (t[0] < r.solve_time) {
+            r.solve_time = t[0];
+            r.iter_time = t[1];
+            r.bottom_time = t[2];
+            r.level_time.assign(t.begin()+3, t.begin()+3+nlevs);
+            r.level_smooth_time.assign(t.begin()+3+nlevs, t.end());
+            r.level_nsmooth = mlmg.getMGLevelNumSmooths();
+            r.niters = mlmg.getNumIters();
+            r.final_resid = (mlmg.getInitResidual() > 0.)
+                ? mlmg.getFinalResidual()/mlmg.getInitResidual() : 0.;
+        }
+    }
+
+    for (int mglev = 0, nlevs = mlmg.getNumMGLevels(); mglev < nlevs; ++mglev) {
+        r.level_ncells.push_back(mlmg.getMGLevelBoxArray(mglev).numPts());
+        r.level_nboxes.push_back(mlmg.getMGLevelBoxArray(mglev).size());
+    }
+
+    // FillBoundary versus the compute part of out = L(in) on the finest level
+    MultiFab out(ba, dmap, 1, 0);
+    {
+        Gpu::streamSynchronize();
+        ParallelDescriptor::Barrier();
+        t0 = amrex::second();
+        for (int i = 0; i < p.nreps; ++i) {
+            sol.FillBoundary(geom.periodicity());
+        }
+        Gpu::streamSynchronize();
+        r.fb_time = (amrex::second() - t0) / p.nreps;
+
+        ParallelDescriptor::Barrier();
+        t0 = amrex::second();
+        for (int i = 0; i < p.nreps; ++i) {
+            mlmg.apply({&out}, {&sol});
+        }
+        Gpu::streamSynchronize();
+        r.apply_time = (amrex::second() - t0) / p.nreps;
+
+        Vector<double> t{r.fb_time, r.apply_time};
+        ParallelReduce::Max<double>(t.data(), t.size(), ParallelDescriptor::IOProcessorNumber(),
+                                    ParallelDescriptor::Communicator());
+        r.fb_time = t[0];
+        r.apply_time = t[1];
+    }
+
+    ParallelReduce::Max<double>(r.tuning_time, ParallelDescriptor::IOProcessorNumber(),
+                                ParallelDescriptor::Communicator());
+    ParallelReduce::Max<double>(r.setup_time, ParallelDescriptor::IOProcessorNumber(),
+                                ParallelDescriptor::Communicator());
+
+    return r;
+}
+
+void write_json (std::ostream& os, Params const& p, Vector<Result> const& results)
+{
+    os << std::setprecision(6);
+    os << "{\n"
+       << "  \"benchmark\": \"MLMG\",\n"
+       << "  \"amrex_version\": \"" << amrex::Version() << "\",\n"
+       << "  \"spacedim\": " << AMREX_SPACEDIM << ",\n"
+       << "  \"nranks\": " << ParallelDescriptor::NProcs() << ",\n"
+       << "  \"bottom_solver\": \"" << p.bottom_solver << "\",\n"
+       << "  \"reltol\": " << p.reltol << ",\n"
+       << "  \"cases\": [";
+    for (int n = 0, N = results.size(); n < N; ++n)
+    {
+        Result const& r = results[n];
+        const int niters = std::max(r.niters, 1);
+        os << (n == 0 ? "\n" : ",\n")
+           << "    {\n"
+           << "      \"operator\": \"" << r.op << "\",\n"
+           << "      \"n_cell\": " << r.n_cell << ",\n"
+           << "      \"max_grid_size\": " << r.max_grid_size << ",\n"
+           << "      \"nboxes\": " << r.nboxes << ",\n"
+           << "      \"nranks\": " << ParallelDescriptor::NProcs() << ",\n"
+           << "      \"nthreads\": " << r.nthreads << ",\n"
+           << "      \"agg_grid_size\": " << r.agg_grid_size << ",\n"
+           << "      \"con_grid_size\": " << r.con_grid_size << ",\n"
+           << "      \"niters\": " << r.niters << ",\n"
+           << "      \"final_resid_rel\": " << r.final_resid << ",\n"
+           << "      \"tuning_time\": " << r.tuning_time << ",\n"
+           << "      \"tuning_trials\": [";
+        for (int i = 0, N = r.tuning_trials.size(); i < N; ++i)
+        {
+            auto const& t = r.tuning_trials[i];
+            os << (i == 0 ? "" : ", ")
+               << "{\"agg_grid_size\": " << t.agg_grid_size
+               << ", \"con_grid_size\": " << t.con_grid_size
+               << ", \"niters\": " << t.niters
+               << ", \"time\": " << t.time
+               << ", \"rejected\": " << (t.rejected ? "true" : "false") << "}";
+        }
+        os << "],\n"
+           << "      \"first_solve_time\": " << r.setup_time << ",\n"
+           << "      \"solve_time\": " << r.solve_time << ",\n"
+           << "      \"vcycle_time\": " << r.iter_time/niters << ",\n"
+           << "      \"bottom_time\": " << r.bottom_time << ",\n"
+           << "      \"bottom_fraction\": " << ((r.solve_time > 0.) ? r.bottom_time/r.solve_time : 0.) << ",\n"
+           << "      \"fillboundary_time\": " << r.fb_time << ",\n"
+           << "      \"apply_time\": " << r.apply_time << ",\n"
+           << "      \"apply_compute_time\": " << std::max(r.apply_time-r.fb_time, 0.) << ",\n"
+           << "      \"levels\": [";
+        for (int lev = 0, nlevs = r.level_time.size(); lev < nlevs; ++lev)
+        {
+            const double bytes = double(smoother_bytes_per_point(r.op)) * double(r.level_ncells[lev])
+                * double(r.level_nsmooth[lev]);
+            const double gbs = (r.level_smooth_time[lev] > 0.) ? bytes/r.level_smooth_time[lev]*1.e-9 : 0.;
+            os << (lev == 0 ? "\n" : ",\n")
+               << "        {\"mglev\": " << lev
+               << ", \"ncells\": " << r.level_ncells[lev]
+               << ", \"nboxes\": " << r.level_nboxes[lev]
+               << ", \"time_per_vcycle\": " << r.level_time[lev]/niters
+               << ", \"smooth_time_per_vcycle\": " << r.level_smooth_time[lev]/niters
+               << ", \"smooth_gbs\": " << gbs << "}";
+        }
+        os << "\n      ]\n"
+           << "    }";
+    }
+    os << "\n  ]\n}\n";
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        BL_PROFILE("main()");
+
+        Params p;
+        {
+            ParmParse pp;
+            pp.queryarr("operators", p.operators);
+            pp.queryarr("n_cell", p.n_cell);
+            pp.queryarr("max_grid_size", p.max_grid_size);
+            pp.queryarr("nthreads", p.nthreads);
+            pp.queryarr("agg_grid_size", p.agg_grid_size);
+            pp.queryarr("con_grid_size", p.con_grid_size);
+            pp.query("bottom_solver", p.bottom_solver);
+            pp.query("nsolves", p.nsolves);
+            pp.query("nreps", p.nreps);
+            pp.query("max_iter", p.max_iter);
+            pp.query("reltol", p.reltol);
+            pp.query("verbose", p.verbose);
+            pp.query("tune_grid_sizes", p.tune_grid_sizes);
+            pp.query("tune_max_iters", p.tune_max_iters);
+            pp.query("output", p.output);
+        }
+
+        Vector<Result> results;
+        for (auto const& op : p.operators) {
+        for (int n_cell : p.n_cell) {
+        for (int max_grid_size : p.max_grid_size) {
+        for (int nthreads : p.nthreads) {
+#ifdef AMREX_USE_OMP
+            if (nthreads > 0) omp_set_num_threads(nthreads);
+#else
+            amrex::ignore_unused(nthreads);
+#endif
+        for (int agg_grid_size : p.agg_grid_size) {
+        for (int con_grid_size : p.con_grid_size) {
+            results.push_back(run_case(p, op, n_cell, max_grid_size,
+                                       agg_grid_size, con_grid_size));
+            Result const& r = results.back();
+            amrex::Print() << "MLMGBenchmark: " << r.op << " n_cell = " << n_cell
+                           << " max_grid_size = " << max_grid_size
+                           << " nthreads = " << r.nthreads
+                           << " agg/con = " << r.agg_grid_size << "/" << r.con_grid_size
+                           << ": " << r.niters << " iters, solve " << r.solve_time
+                           << " s, bottom " << r.bottom_time << " s\n";
+        }}}}}}
+
+        if (ParallelDescriptor::IOProcessor()) {
+            std::ofstream ofs(p.output);
+            if (!ofs.good()) {
+                amrex::FileOpenFailed(p.output);
+            }
+            write_json(ofs, p, results);
+        }
+    }
+    amrex::Finalize();
+}
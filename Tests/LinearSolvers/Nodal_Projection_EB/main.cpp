@@ -43,6 +43,7 @@ int main (int argc, char* argv[])
         int n_cell = 128;
         int max_grid_size = 32;
         int use_hypre  = 0;
+        int use_amg    = 0;
 
         Real obstacle_radius = 0.10;
 
@@ -54,6 +55,7 @@ int main (int argc, char* argv[])
             pp.query("n_cell", n_cell);
             pp.query("max_grid_size", max_grid_size);
             pp.query("use_hypre", use_hypre);
+            pp.query("use_amg", use_amg);
         }
 
 #ifndef AMREX_USE_HYPRE
@@ -245,6 +247,9 @@ int main (int argc, char* argv[])
         //   ( we could also have set this to cg, bicgcg, cgbicg)
         // if (use_hypre_as_full_solver || use_hypre_as_bottom_solver)
         //    nodal_solver.setBottomSolver(MLMG::BottomSolver::hypre);
+        if (use_amg) {
+            nodal_solver.setBottomSolver(MLMG::BottomSolver::amg);
+        }
 
         // Define the relative tolerance
         Real reltol = 1.e-8;
@@ -227,6 +227,125 @@ void MDParticleContainer::moveParticles(amrex::ParticleReal dx)
     }
 }
 
+void MDParticleContainer::perturbParticles(amrex::ParticleReal amplitude)
+{
+    BL_PROFILE("MDParticleContainer::perturbParticles");
+
+    const int lev = 0;
+    auto& plev  = GetParticles(lev);
+
+    for(MFIter mfi = MakeMFIter(lev); mfi.isValid(); ++mfi)
+    {
+        int gid = mfi.index();
+        int tid = mfi.LocalTileIndex();
+
+        auto& ptile = plev[std::make_pair(gid, tid)];
+        auto& aos   = ptile.GetArrayOfStructs();
+        ParticleType* pstruct = aos().dataPtr();
+
+        const size_t np = aos.numParticles();
+
+        // a deterministic displacement that differs between particles
+        AMREX_FOR_1D ( np, i,
+        {
+            ParticleType& p = pstruct[i];
+            for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+                p.pos(dir) += amplitude*std::sin(static_cast<amrex::ParticleReal>(p.id()*(dir+2)));
+            }
+        });
+    }
+}
+
+namespace
+{
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    amrex::ParticleReal pairForceCoef (amrex::ParticleReal r2)
+    {
+        r2 = amrex::max(r2, static_cast<amrex::ParticleReal>(Params::min_r*Params::min_r));
+        return static_cast<amrex::ParticleReal>(1.0)/(r2*(r2+1));
+    }
+}
+
+void MDParticleContainer::checkPairForces()
+{
+    BL_PROFILE("MDParticleContainer::checkPairForces");
+
+    const int lev = 0;
+    auto& plev  = GetParticles(lev);
+
+    for (MFIter mfi = MakeMFIter(lev); mfi.isValid(); ++mfi)
+    {
+        int gid = mfi.index();
+        int tid = mfi.LocalTileIndex();
+        auto index = std::make_pair(gid, tid);
+
+        auto& ptile = plev[index];
+        const int np = ptile.numParticles();
+        const int np_total = ptile.numTotalParticles();
+        const ParticleType* pstruct = ptile.GetArrayOfStructs()().dataPtr();
+
+        // the reference, one neighbor at a time
+        Gpu::DeviceVector<ParticleReal> f_ref(np*AMREX_SPACEDIM, 0.0);
+        ParticleReal* pf_ref = f_ref.dataPtr();
+        auto nbor_data = m_neighbor_list[lev][index].data();
+        AMREX_FOR_1D ( np, i,
+        {
+            for (const auto& p2 : nbor_data.getNeighbors(i))
+            {
+                ParticleReal r2 = 0.0;
+                ParticleReal dr[AMREX_SPACEDIM];
+                for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+                    dr[dir] = pstruct[i].pos(dir) - p2.pos(dir);
+                    r2 += dr[dir]*dr[dir];
+                }
+                ParticleReal coef = pairForceCoef(r2);
+                for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+                    pf_ref[dir*np+i] += coef*dr[dir];
+                }
+            }
+        });
+
+        // blocks of neighbors, with the full and the half list
+        for (int half = 0; half < 2; ++half)
+        {
+            Gpu::DeviceVector<ParticleReal> f(np_total*AMREX_SPACEDIM, 0.0);
+            GpuArray<ParticleReal*, AMREX_SPACEDIM> pf;
+            for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+                pf[dir] = f.dataPtr() + dir*np_total;
+            }
+
+            computePairForces<8>(m_neighbor_list[lev][index], np, pf,
+            [=] AMREX_GPU_DEVICE (int, NeighborBlock<8>& b) noexcept
+            {
+                AMREX_PRAGMA_SIMD
+                for (int k = 0; k < b.n; ++k) {
+                    ParticleReal r2 = AMREX_D_TERM(b.dr[0][k]*b.dr[0][k],
+                                                 + b.dr[1][k]*b.dr[1][k],
+                                                 + b.dr[2][k]*b.dr[2][k]);
+                    ParticleReal coef = pairForceCoef(r2);
+                    for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+                        b.force[dir][k] = coef*b.dr[dir][k];
+                    }
+                }
+            }, half);
+
+            Gpu::HostVector<ParticleReal> h_f(f.size());
+            Gpu::HostVector<ParticleReal> h_f_ref(f_ref.size());
+            Gpu::copy(Gpu::deviceToHost, f.begin(), f.end(), h_f.begin());
+            Gpu::copy(Gpu::deviceToHost, f_ref.begin(), f_ref.end(), h_f_ref.begin());
+
+            for (int i = 0; i < np; ++i) {
+                for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+                    AMREX_ALWAYS_ASSERT(amrex::Math::abs(h_f[dir*np_total+i] - h_f_ref[dir*np+i])
+                                        <= 1.e-4*(1.0 + amrex::Math::abs(h_f_ref[dir*np+i])));
+                }
+            }
+        }
+    }
+
+    amrex::PrintToFile("neighbor_test") << "All the pair forces match!" << std::endl;
+}
+
 void MDParticleContainer::writeParticles(const int n)
 {
     BL_PROFILE("MDParticleContainer::writeParticles");
@@ -23,6 +23,10 @@ void testNeighborParticles();
 
 void testNeighborList();
 
+void testVerletNeighborList();
+
+void testPairForces();
+
 int main (int argc, char* argv[])
 {
     amrex::Initialize(argc,argv);
@@ -33,6 +37,12 @@ int main (int argc, char* argv[])
     amrex::PrintToFile("neighbor_test") << "Running neighbor list test \n";
     testNeighborList();
 
+    amrex::PrintToFile("neighbor_test") << "Running Verlet neighbor list test \n";
+    testVerletNeighborList();
+
+    amrex::PrintToFile("neighbor_test") << "Running pair force test \n";
+    testPairForces();
+
     amrex::Finalize();
 }
 
@@ -75,6 +85,9 @@ void testNeighborParticles ()
     const int ncells = 1;
     MDParticleContainer pc(geom, dm, ba, ncells);
 
+    // the runtime real component holds the grid index, which is exact in single precision
+    pc.setRealCommMode(AMREX_SPACEDIM + PIdx::ncomps, ParticleCommMode::Float);
+
     int npc = params.num_ppc;
     IntVect nppc = IntVect(AMREX_D_DECL(npc, npc, npc));
 
@@ -191,3 +204,121 @@ void testNeighborList ()
                              {"dummy"}, geom, 0.0, 0);
     pc.WritePlotFile("NeighborParticles_plt00001", "neighbors");
 }
+
+struct CheckPairWithSkin
+{
+    template <class P>
+    AMREX_GPU_DEVICE AMREX_FORCE_INLINE
+    bool operator()(const P& p1, const P& p2) const
+    {
+        AMREX_D_TERM(amrex::Real d0 = (p1.pos(0) - p2.pos(0));,
+                     amrex::Real d1 = (p1.pos(1) - p2.pos(1));,
+                     amrex::Real d2 = (p1.pos(2) - p2.pos(2));)
+        amrex::Real dsquared = AMREX_D_TERM(d0*d0, + d1*d1, + d2*d2);
+        amrex::Real r = 5.0*Params::cutoff + Params::skin;
+        return (dsquared <= r*r);
+    }
+};
+
+void testVerletNeighborList ()
+{
+    BL_PROFILE("testVerletNeighborList");
+    TestParams params;
+    get_test_params(params, "nbor_list");
+
+    RealBox real_box;
+    for (int n = 0; n < BL_SPACEDIM; n++)
+    {
+        real_box.setLo(n, 0.0);
+        real_box.setHi(n, params.size[n]);
+    }
+
+    IntVect domain_lo(AMREX_D_DECL(0, 0, 0));
+    IntVect domain_hi(AMREX_D_DECL(params.size[0]-1,params.size[1]-1,params.size[2]-1));
+    const Box domain(domain_lo, domain_hi);
+
+    int coord = 0;
+    int is_per[BL_SPACEDIM];
+    for (int i = 0; i < BL_SPACEDIM; i++)
+        is_per[i] = params.is_periodic;
+    Geometry geom(domain, &real_box, coord, is_per);
+
+    BoxArray ba(domain);
+    ba.maxSize(params.max_grid_size);
+    DistributionMapping dm(ba);
+
+    // the neighbor cells have to cover the cutoff plus the skin
+    const int ncells = 2;
+    MDParticleContainer pc(geom, dm, ba, ncells);
+    pc.setVerletSkin(Params::skin);
+
+    int npc = params.num_ppc;
+    IntVect nppc = IntVect(AMREX_D_DECL(npc, npc, npc));
+    pc.InitParticles(nppc, 1.0, 0.0);
+
+    AMREX_ALWAYS_ASSERT(pc.updateNeighborList(CheckPairWithSkin()));
+
+    // Moving every particle by (0.1, 0.1, 0.1) per step, the list has to be
+    // rebuilt once the displacement exceeds half the skin, i.e. every other step.
+    const int nsteps = 6;
+    int nrebuilds = 0;
+    for (int step = 1; step <= nsteps; ++step)
+    {
+        pc.moveParticles(static_cast<amrex::ParticleReal> (0.1));
+        bool rebuilt = pc.updateNeighborList(CheckPairWithSkin());
+        AMREX_ALWAYS_ASSERT(rebuilt == (step % 2 == 0));
+        nrebuilds += rebuilt;
+
+        auto min_max = pc.minAndMaxDistance();
+        amrex::PrintToFile("neighbor_test") << "Step " << step << ": rebuilt = " << rebuilt
+                                            << ", min distance is " << min_max << "\n";
+        if (ParallelDescriptor::IOProcessor()) {
+            AMREX_ALWAYS_ASSERT(amrex::Math::abs(min_max.first - 1.0) < 1.e-6);
+        }
+    }
+
+    amrex::PrintToFile("neighbor_test") << "The neighbor list was rebuilt " << nrebuilds
+                                        << " times in " << nsteps << " steps \n";
+}
+
+void testPairForces ()
+{
+    BL_PROFILE("testPairForces");
+    TestParams params;
+    get_test_params(params, "nbor_list");
+
+    RealBox real_box;
+    for (int n = 0; n < BL_SPACEDIM; n++)
+    {
+        real_box.setLo(n, 0.0);
+        real_box.setHi(n, params.size[n]);
+    }
+
+    IntVect domain_lo(AMREX_D_DECL(0, 0, 0));
+    IntVect domain_hi(AMREX_D_DECL(params.size[0]-1,params.size[1]-1,params.size[2]-1));
+    const Box domain(domain_lo, domain_hi);
+
+    int coord = 0;
+    int is_per[BL_SPACEDIM];
+    for (int i = 0; i < BL_SPACEDIM; i++)
+        is_per[i] = params.is_periodic;
+    Geometry geom(domain, &real_box, coord, is_per);
+
+    BoxArray ba(domain);
+    ba.maxSize(params.max_grid_size);
+    DistributionMapping dm(ba);
+
+    const int ncells = 1;
+    MDParticleContainer pc(geom, dm, ba, ncells);
+
+    int npc = params.num_ppc;
+    IntVect nppc = IntVect(AMREX_D_DECL(npc, npc, npc));
+    pc.InitParticles(nppc, 1.0, 0.0);
+    pc.perturbParticles(static_cast<amrex::ParticleReal> (0.2));
+    pc.Redistribute();
+
+    pc.fillNeighbors();
+    pc.buildNeighborList(CheckPair());
+
+    pc.checkPairForces();
+}
@@ -0,0 +1,430 @@
+/*
+ * Performance benchmark for the particle classes.
+ *
+ * For every combination of domain size, box size, particles per cell,
+ * particle distribution and number of threads, the following operations
+ * are timed on a periodic single level domain:
+ *
+ *   redistribute    Redistribute() after a random fraction of the particles
+ *                   moved by up to one cell, for each of move_fraction
+ *   p2m             ParticleToMesh() of the mass with linear weights
+ *   m2p             MeshToParticle() of a vector field with linear weights
+ *   fill_neighbors  fillNeighbors() with one cell of neighbors
+ *   neighbor_list   buildNeighborList() with a cutoff of one cell
+ *   reduce          ReduceSum() of the mass
+ *   checkpoint      Checkpoint() to io_dir
+ *   restart         Restart() from io_dir
+ *
+ * Each operation is repeated nreps times and the fastest repetition is
+ * reported, together with the particles processed per second.  All times
+ * are the maximum over the MPI ranks.  The results are written as a JSON
+ * document by the I/O process.  Run the benchmark with different numbers
+ * of MPI ranks to sweep over ranks.
+ *
+ * With distribution = clustered, the particles are drawn from a Gaussian
+ * centered in the domain with a standard deviation of cluster_width times
+ * the domain length, so that the particles per box, and per rank, are
+ * far from uniform.
+ */
+
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_NeighborParticles.H>
+#include <AMReX_ParticleMesh.H>
+#include <AMReX_ParticleInterpolators.H>
+#include <AMReX_ParticleReduce.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_ParallelReduce.H>
+#include <AMReX_OpenMP.H>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <string>
+
+using namespace amrex;
+
+namespace {
+
+using PC = NeighborParticleContainer<1+AMREX_SPACEDIM, 0>;  // mass, velocity
+using ParticleType = PC::ParticleType;
+
+struct Params
+{
+    Vector<int> n_cell{64};
+    Vector<int> max_grid_size{32};
+    Vector<int> nppc{1};
+    Vector<std::string> distributions{"uniform"};
+    Vector<int> nthreads{0};       // 0: do not change the number of threads
+    Vector<Real> move_fraction{0.01, 0.1, 1.0};
+    Vector<std::string> benchmarks{"redistribute", "p2m", "m2p", "fill_neighbors",
+                                   "neighbor_list", "reduce", "checkpoint", "restart"};
+    Real cluster_width = 0.1;
+    int nreps = 5;
+    std::string io_dir = "particle_benchmark_chk";
+    std::string output = "particle_benchmark.json";
+};
+
+struct Result
+{
+    std::string name;
+    std::string distribution;
+    int n_cell = 0;
+    int max_grid_size = 0;
+    int nppc = 0;
+    int nthreads = 0;
+    int nboxes = 0;
+    Long nparticles = 0;
+    Real move_fraction = -1.;      // only used by redistribute
+    double time = std::numeric_limits<double>::max();
+};
+
+struct CheckPair
+{
+    Real cutoff2;
+
+    template <class P>
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    bool operator() (const P& p1, const P& p2) const
+    {
+        AMREX_D_TERM(Real d0 = (p1.pos(0) - p2.pos(0));,
+                     Real d1 = (p1.pos(1) - p2.pos(1));,
+                     Real d2 = (p1.pos(2) - p2.pos(2));)
+        return AMREX_D_TERM(d0*d0, + d1*d1, + d2*d2) <= cutoff2;
+    }
+};
+
+bool do_benchmark (Params const& p, std::string const& name)
+{
+    return std::find(p.benchmarks.begin(), p.benchmarks.end(), name) != p.benchmarks.end();
+}
+
+void init_particles (PC& pc, Params const& p, std::string const& distribution, int nppc)
+{
+    BL_PROFILE("ParticleBenchmark::init_particles()");
+
+    const int lev = 0;
+    const Geometry& geom = pc.Geom(lev);
+    const auto plo = geom.ProbLoArray();
+    const auto phi = geom.ProbHiArray();
+    const auto dx = geom.CellSizeArray();
+
+    if (distribution != "uniform" && distribution != "clustered") {
+        amrex::Abort("ParticleBenchmark: unknown distribution "+distribution);
+    }
+    const bool clustered = (distribution == "clustered");
+
+    for (MFIter mfi = pc.MakeMFIter(lev); mfi.isValid(); ++mfi)
+    {
+        const Box& tile_box = mfi.tilebox();
+
+        Gpu::HostVector<ParticleType> host_particles;
+        host_particles.reserve(tile_box.numPts()*nppc);
+        for (IntVect iv = tile_box.smallEnd(); iv <= tile_box.bigEnd(); tile_box.next(iv))
+        {
+            for (int n = 0; n < nppc; ++n)
+            {
+                ParticleType part;
+                part.id()  = ParticleType::NextID();
+                part.cpu() = ParallelDescriptor::MyProc();
+                for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                    Real x;
+                    if (clustered) {
+                        const Real len = phi[idim] - plo[idim];
+                        x = amrex::RandomNormal(plo[idim] + 0.5*len, p.cluster_width*len);
+                        x = plo[idim] + (x - plo[idim]) - len*std::floor((x - plo[idim])/len);
+                        x = amrex::min(x, phi[idim] - 1.e-6*dx[idim]);
+                    } else {
+                        x = plo[idim] + (iv[idim] + amrex::Random())*dx[idim];
+                    }
+                    part.pos(idim) = static_cast<ParticleReal>(x);
+                    part.rdata(1+idim) = 0.;
+                }
+                part.rdata(0) = 1.;
+                host_particles.push_back(part);
+            }
+        }
+
+        auto& ptile = pc.DefineAndReturnParticleTile(lev, mfi.index(), mfi.LocalTileIndex());
+        auto old_size = ptile.GetArrayOfStructs().size();
+        ptile.resize(old_size + host_particles.size());
+        Gpu::copyAsync(Gpu::hostToDevice, host_particles.begin(), host_particles.end(),
+                       ptile.GetArrayOfStructs().begin() + old_size);
+        Gpu::streamSynchronize();
+    }
+
+    pc.Redistribute();
+}
+
+// Move a random fraction of the particles by up to one cell in each direction.
+void move_particles (PC& pc, Real move_fraction)
+{
+    BL_PROFILE("ParticleBenchmark::move_particles()");
+
+    const int lev = 0;
+    const auto dx = pc.Geom(lev).CellSizeArray();
+    for (PC::ParIterType pti(pc, lev); pti.isValid(); ++pti)
+    {
+        auto* pstruct = pti.GetArrayOfStructs()().dataPtr();
+        amrex::ParallelForRNG(pti.numParticles(),
+        [=] AMREX_GPU_DEVICE (int i, RandomEngine const& engine) noexcept
+        {
+            if (amrex::Random(engine) < move_fraction) {
+                for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                    pstruct[i].pos(idim) += static_cast<ParticleReal>
+                        ((2.*amrex::Random(engine) - 1.)*dx[idim]);
+                }
+            }
+        });
+    }
+    Gpu::streamSynchronize();
+}
+
+// Time f nreps times, and return the fastest time, which is the maximum
+// over the ranks.  setup is called before each repetition and is not timed.
+template <typename S, typename F>
+double time_it (int nreps, S&& setup, F&& f)
+{
+    double best = std::numeric_limits<double>::max();
+    for (int irep = 0; irep < nreps; ++irep)
+    {
+        setup();
+        Gpu::streamSynchronize();
+        ParallelDescriptor::Barrier();
+        double t0 = amrex::second();
+        f();
+        Gpu::streamSynchronize();
+        double t = amrex::second() - t0;
+        ParallelDescriptor::ReduceRealMax(t);
+        best = std::min(best, t);
+    }
+    return best;
+}
+
+void run_case (Params const& p, std::string const& distribution, int n_cell,
+               int max_grid_size, int nppc, Vector<Result>& results)
+{
+    BL_PROFILE("ParticleBenchmark::run_case()");
+
+    RealBox rb({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+    Array<int,AMREX_SPACEDIM> is_periodic{AMREX_D_DECL(1,1,1)};
+    Box domain(IntVect(0), IntVect(n_cell-1));
+    Geometry geom(domain, rb, 0, is_periodic);
+
+    BoxArray ba(domain);
+    ba.maxSize(max_grid_size);
+    DistributionMapping dm(ba);
+
+    const int num_neighbor_cells = 1;
+    PC pc(geom, dm, ba, num_neighbor_cells);
+    init_particles(pc, p, distribution, nppc);
+
+    Result base;
+    base.distribution = distribution;
+    base.n_cell = n_cell;
+    base.max_grid_size = max_grid_size;
+    base.nppc = nppc;
+    base.nthreads = OpenMP::get_max_threads();
+    base.nboxes = ba.size();
+    base.nparticles = pc.TotalNumberOfParticles();
+
+    auto no_setup = [] () {};
+    auto add_result = [&] (std::string const& name, double t, Real move_fraction = -1.)
+    {
+        Result r = base;
+        r.name = name;
+        r.time = t;
+        r.move_fraction = move_fraction;
+        results.push_back(r);
+        amrex::Print() << "ParticleBenchmark: " << name << " " << distribution
+                       << " n_cell = " << n_cell << " max_grid_size = " << max_grid_size
+                       << " nppc = " << nppc << " nthreads = " << r.nthreads;
+        if (move_fraction >= 0.) amrex::Print() << " move_fraction = " << move_fraction;
+        amrex::Print() << ": " << t << " s, "
+                       << static_cast<double>(r.nparticles)/t << " particles/s\n";
+    };
+
+    if (do_benchmark(p, "redistribute")) {
+        for (Real frac : p.move_fraction) {
+            double t = time_it(p.nreps, [&] () { move_particles(pc, frac); },
+                               [&] () { pc.Redistribute(); });
+            add_result("redistribute", t, frac);
+        }
+    }
+
+    const auto plo = geom.ProbLoArray();
+    const auto dxi = geom.InvCellSizeArray();
+
+    if (do_benchmark(p, "p2m")) {
+        MultiFab rho(ba, dm, 1, 1);
+        double t = time_it(p.nreps, [&] () { rho.setVal(0.0); }, [&] ()
+        {
+            amrex::ParticleToMesh(pc, rho, 0,
+            [=] AMREX_GPU_DEVICE (const PC::ParticleType& part, Array4<Real> const& rho_arr)
+            {
+                ParticleInterpolator::Linear interp(part, plo, dxi);
+                interp.ParticleToMesh(part, rho_arr, 0, 0, 1,
+                    [=] AMREX_GPU_DEVICE (const PC::ParticleType& pp, int comp)
+                    {
+                        return pp.rdata(comp);
+                    });
+            });
+        });
+        add_result("p2m", t);
+    }
+
+    if (do_benchmark(p, "m2p")) {
+        MultiFab acc(ba, dm, AMREX_SPACEDIM, 1);
+        acc.setVal(1.0);
+        double t = time_it(p.nreps, no_setup, [&] ()
+        {
+            amrex::MeshToParticle(pc, acc, 0,
+            [=] AMREX_GPU_DEVICE (PC::ParticleType& part, Array4<const Real> const& acc_arr)
+            {
+                ParticleInterpolator::Linear interp(part, plo, dxi);
+                interp.MeshToParticle(part, acc_arr, 0, 1, AMREX_SPACEDIM,
+                    [=] AMREX_GPU_DEVICE (Array4<const Real> const& arr, int i, int j, int k, int comp)
+                    {
+                        return arr(i, j, k, comp);
+                    },
+                    [=] AMREX_GPU_DEVICE (PC::ParticleType& pp, int comp, Real val)
+                    {
+                        pp.rdata(comp) = val;
+                    });
+            });
+        });
+        add_result("m2p", t);
+    }
+
+    if (do_benchmark(p, "fill_neighbors") || do_benchmark(p, "neighbor_list")) {
+        double t = time_it(p.nreps, [&] () { pc.clearNeighbors(); },
+                           [&] () { pc.fillNeighbors(); });
+        if (do_benchmark(p, "fill_neighbors")) add_result("fill_neighbors", t);
+        if (do_benchmark(p, "neighbor_list")) {
+            const Real cutoff = geom.CellSize(0);
+            t = time_it(p.nreps, no_setup, [&] () { pc.buildNeighborList(CheckPair{cutoff*cutoff}); });
+            add_result("neighbor_list", t);
+        }
+        pc.clearNeighbors();
+    }
+
+    if (do_benchmark(p, "reduce")) {
+        Real mass = 0.;
+        double t = time_it(p.nreps, no_setup, [&] ()
+        {
+            mass = amrex::ReduceSum(pc, [=] AMREX_GPU_HOST_DEVICE (const PC::ParticleType& part) -> Real
+            {
+                return part.rdata(0);
+            });
+        });
+        amrex::ignore_unused(mass);
+        add_result("reduce", t);
+    }
+
+    if (do_benchmark(p, "checkpoint") || do_benchmark(p, "restart")) {
+        double t = time_it(do_benchmark(p, "checkpoint") ? p.nreps : 1, no_setup,
+                           [&] () { pc.Checkpoint(p.io_dir, "particles"); });
+        if (do_benchmark(p, "checkpoint")) add_result("checkpoint", t);
+        if (do_benchmark(p, "restart")) {
+            PC pc_restart(geom, dm, ba, num_neighbor_cells);
+            // Restart adds to the particles already in the container.
+            t = time_it(p.nreps, [&] () { pc_restart.clearParticles(); },
+                        [&] () { pc_restart.Restart(p.io_dir, "particles"); });
+            AMREX_ALWAYS_ASSERT(pc_restart.TotalNumberOfParticles() == base.nparticles);
+            add_result("restart", t);
+        }
+    }
+}
+
+void write_json (std::ostream& os, Params const& p, Vector<Result> const& results)
+{
+    os << std::setprecision(6);
+    os << "{\n"
+       << "  \"benchmark\": \"Particles\",\n"
+       << "  \"amrex_version\": \"" << amrex::Version() << "\",\n"
+       << "  \"spacedim\": " << AMREX_SPACEDIM << ",\n"
+       << "  \"nranks\": " << ParallelDescriptor::NProcs() << ",\n"
+       << "  \"nreps\": " << p.nreps << ",\n"
+       << "  \"particle_bytes\": " << sizeof(ParticleType) << ",\n"
+       << "  \"cases\": [";
+    for (int n = 0, N = results.size(); n < N; ++n)
+    {
+        Result const& r = results[n];
+        os << (n == 0 ? "\n" : ",\n")
+           << "    {\"benchmark\": \"" << r.name << "\""
+           << ", \"distribution\": \"" << r.distribution << "\""
+           << ", \"n_cell\": " << r.n_cell
+           << ", \"max_grid_size\": " << r.max_grid_size
+           << ", \"nboxes\": " << r.nboxes
+           << ", \"nppc\": " << r.nppc
+           << ", \"nparticles\": " << r.nparticles
+           << ", \"nranks\": " << ParallelDescriptor::NProcs()
+           << ", \"nthreads\": " << r.nthreads;
+        if (r.move_fraction >= 0.) {
+            os << ", \"move_fraction\": " << r.move_fraction;
+        }
+        os << ", \"time\": " << r.time
+           << ", \"particles_per_second\": " << static_cast<double>(r.nparticles)/r.time
+           << "}";
+    }
+    os << "\n  ]\n}\n";
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        BL_PROFILE("main()");
+
+        Params p;
+        {
+            ParmParse pp;
+            // queryarr does not shrink a vector, so lists given in the
+            // inputs replace the defaults with getarr.
+            auto query_list = [&pp] (const char* name, auto& v)
+            {
+                if (pp.contains(name)) {
+                    v.clear();
+                    pp.getarr(name, v);
+                }
+            };
+            query_list("n_cell", p.n_cell);
+            query_list("max_grid_size", p.max_grid_size);
+            query_list("nppc", p.nppc);
+            query_list("distributions", p.distributions);
+            query_list("nthreads", p.nthreads);
+            query_list("move_fraction", p.move_fraction);
+            query_list("benchmarks", p.benchmarks);
+            pp.query("cluster_width", p.cluster_width);
+            pp.query("nreps", p.nreps);
+            pp.query("io_dir", p.io_dir);
+            pp.query("output", p.output);
+        }
+
+        Vector<Result> results;
+        for (auto const& distribution : p.distributions) {
+        for (int n_cell : p.n_cell) {
+        for (int max_grid_size : p.max_grid_size) {
+        for (int nppc : p.nppc) {
+        for (int nthreads : p.nthreads) {
+#ifdef AMREX_USE_OMP
+            if (nthreads > 0) omp_set_num_threads(nthreads);
+#else
+            amrex::ignore_unused(nthreads);
+#endif
+            run_case(p, distribution, n_cell, max_grid_size, nppc, results);
+        }}}}}
+
+        if (ParallelDescriptor::IOProcessor()) {
+            std::ofstream ofs(p.output);
+            if (!ofs.good()) {
+                amrex::FileOpenFailed(p.output);
+            }
+            write_json(ofs, p, results);
+        }
+    }
+    amrex::Finalize();
+}
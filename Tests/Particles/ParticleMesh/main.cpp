@@ -127,6 +127,8 @@ void testParticleMesh (TestParams& parms)
               });
       });
 
+  AMREX_ALWAYS_ASSERT(partiMF.sum(0) == myPC.TotalNumberOfParticles());
+
   amrex::MeshToParticle(myPC, partiMF, 0,
                         [=] AMREX_GPU_DEVICE (const MyParticleContainer::ParticleTileType::ParticleTileDataType& ptd, int ip,
                                               amrex::Array4<const int> const& count)
@@ -152,6 +154,33 @@ void testParticleMesh (TestParams& parms)
                            geom, 0.0, 0);
 
   myPC.WritePlotFile("plot", "particle0");
+
+  // Move the particles by half a cell without redistributing them, so that
+  // some of them are outside their tile, and count them again.
+  const Real shift = Real(0.5)/dxi[0];
+  for (MyParticleContainer::ParIterType pti(myPC, 0); pti.isValid(); ++pti)
+  {
+      auto* pstruct = pti.GetArrayOfStructs()().dataPtr();
+      amrex::ParallelFor(pti.numParticles(), [=] AMREX_GPU_DEVICE (int i) noexcept
+      {
+          pstruct[i].pos(0) += shift;
+      });
+  }
+
+  amrex::ParticleToMesh(myPC, partiMF, 0,
+      [=] AMREX_GPU_DEVICE (const MyParticleContainer::SuperParticleType& p,
+                            amrex::Array4<int> const& count)
+      {
+          ParticleInterpolator::Nearest interp(p, plo, dxi);
+
+          interp.ParticleToMesh(p, count, 0, 0, 1,
+              [=] AMREX_GPU_DEVICE (const MyParticleContainer::ParticleType& /*p*/, int /*comp*/) -> int
+              {
+                  return 1;  // just count the particles per cell
+              });
+      });
+
+  AMREX_ALWAYS_ASSERT(partiMF.sum(0) == myPC.TotalNumberOfParticles());
 }
 
 int main(int argc, char* argv[])
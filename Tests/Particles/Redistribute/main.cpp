@@ -38,17 +38,35 @@ void get_position_unit_cell(Real* r, const IntVect& nppc, int i_part)
     r[2] = (0.5+iz_part)/nz;
 }
 
+template <template<class> class Allocator, template<class> class LevelStorage>
 class TestParticleContainer
-    : public amrex::ParticleContainer<NSR, NSI, NAR, NAI>
+    : public amrex::ParticleContainer<NSR, NSI, NAR, NAI, Allocator, LevelStorage>
 {
 
 public:
 
+    using PC = amrex::ParticleContainer<NSR, NSI, NAR, NAI, Allocator, LevelStorage>;
+    using typename PC::ParticleType;
+    using PC::AddIntComp;
+    using PC::AddRealComp;
+    using PC::DefineAndReturnParticleTile;
+    using PC::finestLevel;
+    using PC::Geom;
+    using PC::GetParticles;
+    using PC::MakeMFIter;
+    using PC::NumRuntimeIntComps;
+    using PC::NumRuntimeRealComps;
+    using PC::OK;
+    using PC::Redistribute;
+    using PC::SFCSortedness;
+    using PC::SortParticlesByCell;
+    using PC::SortParticlesBySFC;
+
     TestParticleContainer (const Vector<amrex::Geometry>            & a_geom,
                            const Vector<amrex::DistributionMapping> & a_dmap,
                            const Vector<amrex::BoxArray>            & a_ba,
                            const Vector<amrex::IntVect>             & a_rr)
-        : amrex::ParticleContainer<NSR, NSI, NAR, NAI>(a_geom, a_dmap, a_ba, a_rr)
+        : PC(a_geom, a_dmap, a_ba, a_rr)
     {
         for (int i = 0; i < num_runtime_real; ++i)
         {
@@ -259,6 +277,33 @@ public:
         }
     }
 
+    // Sorted particle ids of every tile, for checking that a sort only
+    // permutes the particles within their tiles.
+    Vector<std::map<std::pair<int,int>, Vector<Long> > > tileIDs () const
+    {
+        Vector<std::map<std::pair<int,int>, Vector<Long> > > ids(finestLevel()+1);
+        for (int lev = 0; lev <= finestLevel(); ++lev)
+        {
+            auto& plev  = GetParticles(lev);
+            for(MFIter mfi = MakeMFIter(lev); mfi.isValid(); ++mfi)
+            {
+                auto index = std::make_pair(mfi.index(), mfi.LocalTileIndex());
+                auto const& aos = plev.at(index).GetArrayOfStructs();
+                const Long np = aos.numParticles();
+                Gpu::HostVector<ParticleType> host_particles(np);
+                Gpu::copyAsync(Gpu::deviceToHost, aos().dataPtr(), aos().dataPtr()+np,
+                               host_particles.begin());
+                Gpu::streamSynchronize();
+                auto& tile_ids = ids[lev][index];
+                for (auto const& p : host_particles) {
+                    tile_ids.push_back(p.id());
+                }
+                std::sort(tile_ids.begin(), tile_ids.end());
+            }
+        }
+        return ids;
+    }
+
     void checkAnswer () const
     {
         BL_PROFILE("TestParticleContainer::checkAnswer");
@@ -324,16 +369,31 @@ struct TestParams
     int do_regrid;
     int sort;
     int test_level_lost = 0;
+    int flat_level_storage = 0;
+    int float_comm = 0;
+    int particle_arena = 0;
 };
 
-void testRedistribute();
+void get_test_params(TestParams& params, const std::string& prefix);
+
+template <template<class> class Allocator, template<class> class LevelStorage>
+void testRedistribute(TestParams const& params);
 
 int main (int argc, char* argv[])
 {
     amrex::Initialize(argc,argv);
 
+    TestParams params;
+    get_test_params(params, "redistribute");
+
     amrex::Print() << "Running redistribute test \n";
-    testRedistribute();
+    if (params.particle_arena) {
+        testRedistribute<ParticleArenaAllocator, DefaultParticleLevel>(params);
+    } else if (params.flat_level_storage) {
+        testRedistribute<DefaultAllocator, FlatParticleLevel>(params);
+    } else {
+        testRedistribute<DefaultAllocator, DefaultParticleLevel>(params);
+    }
 
     amrex::Finalize();
 }
@@ -357,13 +417,15 @@ void get_test_params(TestParams& params, const std::string& prefix)
 
     params.sort = 0;
     pp.query("sort", params.sort);
+    pp.query("flat_level_storage", params.flat_level_storage);
+    pp.query("float_comm", params.float_comm);
+    pp.query("particle_arena", params.particle_arena);
 }
 
-void testRedistribute ()
+template <template<class> class Allocator, template<class> class LevelStorage>
+void testRedistribute (TestParams const& params)
 {
     BL_PROFILE("testRedistribute");
-    TestParams params;
-    get_test_params(params, "redistribute");
 
     int is_per[BL_SPACEDIM];
     for (int i = 0; i < BL_SPACEDIM; i++)
@@ -404,7 +466,14 @@ void testRedistribute ()
         size *= 2;
     }
 
-    TestParticleContainer pc(geom, dm, ba, rr);
+    TestParticleContainer<Allocator, LevelStorage> pc(geom, dm, ba, rr);
+
+    // the ids used as the values of the components are exact in single precision
+    if (params.float_comm) {
+        for (int comp = 0; comp < pc.NumRealComps(); ++comp) {
+            pc.SetRedistributeRealCommMode(comp, ParticleCommMode::Float);
+        }
+    }
 
     int npc = params.num_ppc;
     IntVect nppc = IntVect(AMREX_D_DECL(npc, npc, npc));
@@ -417,7 +486,19 @@ void testRedistribute ()
 
     auto np_old = pc.TotalNumberOfParticles();
 
-    if (params.sort) pc.SortParticlesByCell();
+    auto sort_by_sfc = [&pc] ()
+    {
+        const auto ids = pc.tileIDs();
+        pc.SortParticlesBySFC();
+        AMREX_ALWAYS_ASSERT(pc.tileIDs() == ids);
+#ifndef AMREX_USE_GPU
+        // GPU builds fall back to SortParticlesByCell, which is not in Morton order.
+        AMREX_ALWAYS_ASSERT(pc.SFCSortedness() == 1.0);
+#endif
+    };
+
+    if (params.sort == 1) pc.SortParticlesByCell();
+    if (params.sort == 2) sort_by_sfc();
 
     for (int i = 0; i < params.nsteps; ++i)
     {
@@ -430,10 +511,15 @@ void testRedistribute ()
             pc.negateEven();
         }
         pc.RedistributeLocal();
-        if (params.sort) pc.SortParticlesByCell();
+        if (params.sort == 1) pc.SortParticlesByCell();
+        if (params.sort == 2) sort_by_sfc();
         pc.checkAnswer();
     }
 
+    for (auto const& stats : pc.MemoryStats()) {
+        AMREX_ALWAYS_ASSERT(stats.used_bytes <= stats.reserved_bytes);
+    }
+
     if (params.do_regrid)
     {
         const int NProcs = ParallelDescriptor::NProcs();
@@ -477,6 +563,16 @@ void testRedistribute ()
             pc.checkAnswer();
         }
 
+        {
+            auto np_before_balance = pc.TotalNumberOfParticles();
+            for (int lev = 0; lev < params.nlevs; ++lev)
+            {
+                pc.LoadBalance(lev, pc.ComputeCosts(lev, 1.0, 0.01), 1.1);
+            }
+            pc.checkAnswer();
+            AMREX_ALWAYS_ASSERT(np_before_balance == pc.TotalNumberOfParticles());
+        }
+
         if (params.test_level_lost) {
             AMREX_ALWAYS_ASSERT(params.nlevs > 2);
             auto np_before_level_lost = pc.TotalNumberOfParticles();
@@ -494,6 +590,17 @@ void testRedistribute ()
 
     if (geom[0].isAllPeriodic()) AMREX_ALWAYS_ASSERT(np_old == pc.TotalNumberOfParticles());
 
+    // These iterate over the particles with the container's own iterator
+    // types, so they are compiled for each LevelStorage.  The interpolation
+    // changes the particle data, so it comes after the last checkAnswer.
+    {
+        MultiFab rho(pc.ParticleBoxArray(0), pc.ParticleDistributionMap(0), 1, 1);
+        pc.AssignCellDensitySingleLevel(0, rho, 0);
+        MultiFab field(pc.ParticleBoxArray(0), pc.ParticleDistributionMap(0), 1, 1);
+        field.setVal(0.0);
+        pc.InterpolateSingleLevel(field, 0);
+    }
+
     // the way this test is set up, if we make it here we pass
     amrex::Print() << "pass \n";
 }